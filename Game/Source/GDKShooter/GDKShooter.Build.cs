@@ -26,7 +26,8 @@ public class GDKShooter : ModuleRules
 				"SpatialGDK",
                 "Json",
                 "HTTP",
-                "AIModule"
+                "AIModule",
+                "GameplayTasks"
 			});
 	}
 }
@@ -0,0 +1,90 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "AI/BTTask_FindNearestHostile.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "Engine/World.h"
+#include "Game/Components/PerceptionRegistryComponent.h"
+#include "GameFramework/Pawn.h"
+
+UBTTask_FindNearestHostile::UBTTask_FindNearestHostile(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Radius(5000.f)
+	, bRequireLineOfSight(true)
+	, MaxLineOfSightChecks(4)
+	, LineOfSightCollisionChannel(ECC_Visibility)
+{
+	NodeName = TEXT("Find Nearest Hostile");
+
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_FindNearestHostile, BlackboardKey), AActor::StaticClass());
+	LocationKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_FindNearestHostile, LocationKey));
+	LocationKey.AllowNoneAsValue(true);
+}
+
+void UBTTask_FindNearestHostile::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BlackboardAsset = GetBlackboardAsset())
+	{
+		LocationKey.ResolveSelectedKey(*BlackboardAsset);
+	}
+}
+
+EBTNodeResult::Type UBTTask_FindNearestHostile::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	const AAIController* Controller = OwnerComp.GetAIOwner();
+	const APawn* Pawn = Controller != nullptr ? Controller->GetPawn() : nullptr;
+	const UPerceptionRegistryComponent* PerceptionRegistry = UPerceptionRegistryComponent::Get(Pawn);
+	if (Pawn == nullptr || PerceptionRegistry == nullptr)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	TArray<AActor*> Hostiles;
+	PerceptionRegistry->FindHostilesNear(Pawn, Radius, Hostiles);
+
+	AActor* Hostile = nullptr;
+	if (bRequireLineOfSight)
+	{
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		Pawn->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FindNearestHostile), false, Pawn);
+		for (int32 i = 0; i < Hostiles.Num() && i < MaxLineOfSightChecks; i++)
+		{
+			FHitResult Hit;
+			if (!Pawn->GetWorld()->LineTraceSingleByChannel(Hit, EyeLocation, Hostiles[i]->GetActorLocation(), LineOfSightCollisionChannel, QueryParams)
+				|| Hit.GetActor() == Hostiles[i])
+			{
+				Hostile = Hostiles[i];
+				break;
+			}
+		}
+	}
+	else if (Hostiles.Num() > 0)
+	{
+		Hostile = Hostiles[0];
+	}
+
+	if (Hostile == nullptr)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	Blackboard->SetValueAsObject(BlackboardKey.SelectedKeyName, Hostile);
+	if (LocationKey.SelectedKeyName != NAME_None)
+	{
+		Blackboard->SetValueAsVector(LocationKey.SelectedKeyName, Hostile->GetActorLocation());
+	}
+
+	return EBTNodeResult::Succeeded;
+}
+
+FString UBTTask_FindNearestHostile::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: nearest hostile within %.0f%s"), *Super::GetStaticDescription(), Radius, bRequireLineOfSight ? TEXT(" in sight") : TEXT(""));
+}
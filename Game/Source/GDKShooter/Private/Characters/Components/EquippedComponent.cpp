@@ -4,8 +4,41 @@
 #include "Net/UnrealNetwork.h"
 #include "GDKLogging.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Game/Components/SpawnLatencyTrackerComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GDKStats.h"
+#include "HAL/IConsoleManager.h"
 #include "Weapons/Holdable.h"
 
+DECLARE_CYCLE_STAT(TEXT("Server Equip"), STAT_GDKServerEquip, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Holdables Materialized"), STAT_GDKHoldablesMaterialized, STATGROUP_GDKShooter);
+
+static FAutoConsoleCommandWithWorld InventoryStatsCommand(
+	TEXT("GDK.Inventory.Stats"),
+	TEXT("Logs the number of holdable actors per character, to compare the data only inventory against one actor per held item."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		int32 NumCharacters = 0;
+		int32 NumDataOnly = 0;
+		for (TActorIterator<APawn> It(World); It; ++It)
+		{
+			if (const UEquippedComponent* EquippedComponent = It->FindComponentByClass<UEquippedComponent>())
+			{
+				NumCharacters++;
+				NumDataOnly += EquippedComponent->IsDataOnlyInventory() ? 1 : 0;
+			}
+		}
+
+		int32 NumHoldables = 0;
+		for (TActorIterator<AHoldable> It(World); It; ++It)
+		{
+			NumHoldables++;
+		}
+
+		UE_LOG(LogGDK, Log, TEXT("Inventory: %d holdable actors for %d characters (%.2f per character), %d using the data only inventory"),
+			NumHoldables, NumCharacters, NumCharacters > 0 ? (float)NumHoldables / NumCharacters : 0.f, NumDataOnly);
+	}));
 
 UEquippedComponent::UEquippedComponent()
 {
@@ -40,21 +73,47 @@ void UEquippedComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void UEquippedComponent::SpawnStarterTemplates(FGDKMetaData MetaData)
 {
+	const APawn* OwnerAsPawn = Cast<APawn>(GetOwner());
+	if (OwnerAsPawn != nullptr && OwnerAsPawn->HasAuthority())
+	{
+		USpawnLatencyTrackerComponent::RecordStage(this, OwnerAsPawn->GetController(), ESpawnStage::Equipped);
+	}
+
 	if (!bHeldItemsInitialised && GetOwner()->HasAuthority())
 	{
 		HeldItems.SetNum(HoldableCapacity, false);
 		bHeldItemsInitialised = true;
 
-		for (int i = 0; i < StarterTemplates.Num(); i++)
+		if (bDataOnlyInventory)
 		{
-			if (StarterTemplates[i] == nullptr)
+			ItemRecords.SetNum(HoldableCapacity, false);
+
+			int Slot = 0;
+			for (int i = 0; i < StarterTemplates.Num() && Slot < HoldableCapacity; i++)
 			{
-				continue;
+				if (StarterTemplates[i] == nullptr)
+				{
+					continue;
+				}
+
+				ItemRecords[Slot].HoldableClass = StarterTemplates[i];
+				ItemRecords[Slot].MetaData = MetaData;
+				Slot++;
+			}
+		}
+		else
+		{
+			for (int i = 0; i < StarterTemplates.Num(); i++)
+			{
+				if (StarterTemplates[i] == nullptr)
+				{
+					continue;
+				}
+
+				AHoldable* Starter = GetWorld()->SpawnActor<AHoldable>(StarterTemplates[i], GetOwner()->GetActorTransform());
+				Starter->SetMetaData(MetaData);
+				Grant(Starter);
 			}
-
-			AHoldable* Starter = GetWorld()->SpawnActor<AHoldable>(StarterTemplates[i], GetOwner()->GetActorTransform());
-			Starter->SetMetaData(MetaData);
-			Grant(Starter);
 		}
 
 		// Default to holding the weapon in slot 0
@@ -63,8 +122,99 @@ void UEquippedComponent::SpawnStarterTemplates(FGDKMetaData MetaData)
 			CurrentHeldIndex = 0;
 		}
 
+		if (bDataOnlyInventory)
+		{
+			MaterializeSlot(CurrentHeldIndex);
+		}
+
 		OnRep_HeldUpdate();
 	}
+	else if (bHeldItemsInitialised && GetOwner()->HasAuthority())
+	{
+		// Already equipped, e.g. reused from the pool, so only the meta data needs passing on.
+		for (AHoldable* Holdable : HeldItems)
+		{
+			if (Holdable != nullptr)
+			{
+				Holdable->SetMetaData(MetaData);
+			}
+		}
+
+		for (FHeldItemRecord& Record : ItemRecords)
+		{
+			Record.MetaData = MetaData;
+		}
+	}
+}
+
+void UEquippedComponent::ResetToStarterTemplates()
+{
+	if (!bHeldItemsInitialised || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	StopPrimaryUse();
+	StopSecondaryUse();
+
+	if (bDataOnlyInventory)
+	{
+		DematerializeSlot(CurrentHeldIndex);
+
+		int Slot = 0;
+		for (int i = 0; i < ItemRecords.Num(); i++)
+		{
+			FHeldItemRecord& Record = ItemRecords[i];
+			while (Slot < StarterTemplates.Num() && StarterTemplates[Slot] == nullptr)
+			{
+				Slot++;
+			}
+
+			Record.HoldableClass = Slot < StarterTemplates.Num() ? StarterTemplates[Slot] : nullptr;
+			Record.Mode = 0;
+			Slot++;
+		}
+
+		LastCachedIndex = -1;
+		CurrentHeldIndex = 0;
+		MaterializeSlot(CurrentHeldIndex);
+		OnRep_HeldUpdate();
+		return;
+	}
+
+	TArray<TSubclassOf<AHoldable>> MissingTemplates;
+	for (const TSubclassOf<AHoldable>& Template : StarterTemplates)
+	{
+		if (Template != nullptr)
+		{
+			MissingTemplates.Add(Template);
+		}
+	}
+
+	for (int i = 0; i < HeldItems.Num(); i++)
+	{
+		AHoldable* Holdable = HeldItems[i];
+		if (Holdable == nullptr)
+		{
+			continue;
+		}
+
+		if (MissingTemplates.RemoveSingle(Holdable->GetClass()) == 0)
+		{
+			GetWorld()->DestroyActor(Holdable);
+			HeldItems[i] = nullptr;
+		}
+	}
+
+	for (const TSubclassOf<AHoldable>& Template : MissingTemplates)
+	{
+		Grant(GetWorld()->SpawnActor<AHoldable>(Template, GetOwner()->GetActorTransform()));
+	}
+
+	LastCachedIndex = -1;
+	CurrentHeldIndex = 0;
+	LocallyActiveHoldable = nullptr;
+	OnRep_HeldUpdate();
 }
 
 bool UEquippedComponent::Grant(AHoldable* NewHoldable)
@@ -75,6 +225,16 @@ bool UEquippedComponent::Grant(AHoldable* NewHoldable)
 	}
 
 	int Index = GetNextAvailableSlot();
+	if (bDataOnlyInventory)
+	{
+		// The new holdable becomes the active one, so the current one goes back to being a record.
+		DematerializeSlot(CurrentHeldIndex);
+
+		ItemRecords[Index].HoldableClass = NewHoldable->GetClass();
+		ItemRecords[Index].Mode = NewHoldable->GetCurrentMode();
+		ItemRecords[Index].MetaData = NewHoldable->GetMetaData();
+	}
+
 	NewHoldable->AttachToActor(GetOwner(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 	NewHoldable->SetOwner(GetOwner());
 	HeldItems[Index] = NewHoldable;
@@ -83,23 +243,69 @@ bool UEquippedComponent::Grant(AHoldable* NewHoldable)
 	return true;
 }
 
-bool UEquippedComponent::HasAnyEmptySlots()
+void UEquippedComponent::MaterializeSlot(int32 Index)
 {
-	for (int i = 0; i < HeldItems.Num(); i++)
+	if (!ItemRecords.IsValidIndex(Index) || !HeldItems.IsValidIndex(Index) || ItemRecords[Index].HoldableClass == nullptr || HeldItems[Index] != nullptr)
 	{
-		if (HeldItems[i] == nullptr)
-		{
-			return true;
-		}
+		return;
 	}
-	return false;
+
+	const FHeldItemRecord& Record = ItemRecords[Index];
+	AHoldable* Holdable = GetWorld()->SpawnActor<AHoldable>(Record.HoldableClass, GetOwner()->GetActorTransform());
+	if (Holdable == nullptr)
+	{
+		return;
+	}
+
+	Holdable->SetMetaData(Record.MetaData);
+	Holdable->SetCurrentMode(Record.Mode);
+	Holdable->AttachToActor(GetOwner(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	Holdable->SetOwner(GetOwner());
+	HeldItems[Index] = Holdable;
+	INC_DWORD_STAT(STAT_GDKHoldablesMaterialized);
+}
+
+void UEquippedComponent::DematerializeSlot(int32 Index)
+{
+	if (!ItemRecords.IsValidIndex(Index) || !HeldItems.IsValidIndex(Index) || HeldItems[Index] == nullptr)
+	{
+		return;
+	}
+
+	AHoldable* Holdable = HeldItems[Index];
+	ItemRecords[Index].Mode = Holdable->GetCurrentMode();
+	ItemRecords[Index].MetaData = Holdable->GetMetaData();
+
+	if (LocallyActiveHoldable == Holdable)
+	{
+		LocallyActiveHoldable = nullptr;
+	}
+
+	Holdable->SetIsActive(false);
+	GetWorld()->DestroyActor(Holdable);
+	HeldItems[Index] = nullptr;
+}
+
+TSubclassOf<AHoldable> UEquippedComponent::GetHoldableClassAtIndex(int32 Index) const
+{
+	if (bDataOnlyInventory)
+	{
+		return ItemRecords.IsValidIndex(Index) ? ItemRecords[Index].HoldableClass : nullptr;
+	}
+
+	return HeldItems.IsValidIndex(Index) && HeldItems[Index] != nullptr ? HeldItems[Index]->GetClass() : nullptr;
+}
+
+bool UEquippedComponent::HasAnyEmptySlots()
+{
+	return GetNextAvailableSlot() != -1;
 }
 
 int UEquippedComponent::GetNextAvailableSlot()
 {
 	for (int i = 0; i < HeldItems.Num(); i++)
 	{
-		if (HeldItems[i] == nullptr)
+		if (GetHoldableClassAtIndex(i) == nullptr)
 		{
 			return i;
 		}
@@ -111,7 +317,8 @@ bool UEquippedComponent::AlreadyHas(AHoldable* NewHoldable)
 {
 	for (int i = 0; i < HeldItems.Num(); i++)
 	{
-		if (HeldItems[i] != nullptr && HeldItems[i]->IsA(NewHoldable->GetClass()))
+		const TSubclassOf<AHoldable> HeldClass = GetHoldableClassAtIndex(i);
+		if (HeldClass != nullptr && HeldClass->IsChildOf(NewHoldable->GetClass()))
 		{
 			return true;
 		}
@@ -126,10 +333,13 @@ void UEquippedComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 	DOREPLIFETIME(UEquippedComponent, CurrentHeldIndex);
 	DOREPLIFETIME(UEquippedComponent, HeldItems);
 	DOREPLIFETIME(UEquippedComponent, bHeldItemsInitialised);
+	DOREPLIFETIME(UEquippedComponent, ItemRecords);
+	DOREPLIFETIME_CONDITION(UEquippedComponent, AckedEquipSequence, COND_OwnerOnly);
 }
 
 void UEquippedComponent::OnRep_HeldUpdate()
 {
+	const int32 HeldIndex = GetEffectiveHeldIndex();
 	for (int i = 0; i < HeldItems.Num(); i++)
 	{
 		if(!HeldItems[i])
@@ -137,11 +347,15 @@ void UEquippedComponent::OnRep_HeldUpdate()
 			continue;
 		}
 
-		if (i == CurrentHeldIndex)
+		if (i == HeldIndex)
 		{
-			LastCachedIndex = CurrentCachedIndex;
-			CurrentCachedIndex = CurrentHeldIndex;
-			LocallyActivate(CurrentlyHeldItem());
+			// Already active if it was switched to ahead of the server, activating it again would interrupt using it.
+			if (HeldItems[i] != LocallyActiveHoldable)
+			{
+				LastCachedIndex = CurrentCachedIndex;
+				CurrentCachedIndex = HeldIndex;
+				LocallyActivate(HeldItems[i]);
+			}
 		}
 		else
 		{
@@ -150,17 +364,33 @@ void UEquippedComponent::OnRep_HeldUpdate()
 	}
 }
 
+void UEquippedComponent::OnRep_AckedEquipSequence()
+{
+	if (PredictedHeldIndex != INDEX_NONE && AckedEquipSequence == EquipSequence)
+	{
+		// Back to following the server, which may not have allowed the switch.
+		PredictedHeldIndex = INDEX_NONE;
+		OnRep_HeldUpdate();
+	}
+}
+
+int32 UEquippedComponent::GetEffectiveHeldIndex() const
+{
+	return PredictedHeldIndex != INDEX_NONE ? PredictedHeldIndex : CurrentHeldIndex;
+}
+
 AHoldable* UEquippedComponent::CurrentlyHeldItem() const
 {
-	if (CurrentHeldIndex < 0 || CurrentHeldIndex >= HeldItems.Num())
+	const int32 HeldIndex = GetEffectiveHeldIndex();
+	if (HeldIndex < 0 || HeldIndex >= HeldItems.Num())
 		return nullptr;
 
-	return HeldItems[CurrentHeldIndex];
+	return HeldItems[HeldIndex];
 }
 
 void UEquippedComponent::LocallyActivate(AHoldable* Holdable)
 {
-	if (LocallyActiveHoldable)
+	if (IsValid(LocallyActiveHoldable))
 	{
 		LocallyActiveHoldable->SetIsActive(false);
 	}
@@ -180,21 +410,21 @@ void UEquippedComponent::ToggleMode()
 
 void UEquippedComponent::QuickToggle()
 {
-	ServerRequestEquip(LastCachedIndex);
+	RequestEquip(LastCachedIndex);
 }
 
 bool UEquippedComponent::HasHoldableAtIndex(int32 Index)
 {
-	return Index >= 0 && Index < HeldItems.Num() && HeldItems[Index];
+	return GetHoldableClassAtIndex(Index) != nullptr;
 }
 
 void UEquippedComponent::ScrollUp()
 {
-	for (int i = CurrentHeldIndex + 1; i < HeldItems.Num(); i++)
+	for (int i = GetEffectiveHeldIndex() + 1; i < HeldItems.Num(); i++)
 	{
 		if (HasHoldableAtIndex(i))
 		{
-			ServerRequestEquip(i);
+			RequestEquip(i);
 			return;
 		}
 	}
@@ -202,26 +432,61 @@ void UEquippedComponent::ScrollUp()
 
 void UEquippedComponent::ScrollDown()
 {
-	for (int i = CurrentHeldIndex - 1; i >= 0; i--)
+	for (int i = GetEffectiveHeldIndex() - 1; i >= 0; i--)
 	{
 		if (HasHoldableAtIndex(i))
 		{
-			ServerRequestEquip(i);
+			RequestEquip(i);
 			return;
 		}
 	}
 }
 
-void UEquippedComponent::ServerRequestEquip_Implementation(int32 TargetIndex)
+void UEquippedComponent::RequestEquip(int32 Index)
+{
+	// Already holding it, or about to be.
+	if (Index == GetEffectiveHeldIndex() || !HasHoldableAtIndex(Index))
+	{
+		return;
+	}
+
+	// Continue from the server's sequence when nothing is pending, so the next ack is always a change, e.g. for a pooled character.
+	if (PredictedHeldIndex == INDEX_NONE)
+	{
+		EquipSequence = AckedEquipSequence;
+	}
+	EquipSequence++;
+
+	// Only switch ahead of the server to a holdable the client already has. With the data only inventory the
+	// target slot is normally just a record until the server spawns its holdable, so the client waits for that.
+	if (!GetOwner()->HasAuthority() && HeldItems.IsValidIndex(Index) && HeldItems[Index] != nullptr)
+	{
+		PredictedHeldIndex = Index;
+		OnRep_HeldUpdate();
+	}
+
+	ServerRequestEquip(Index, EquipSequence);
+}
+
+void UEquippedComponent::ServerRequestEquip_Implementation(int32 TargetIndex, int32 Sequence)
 {
+	SCOPE_CYCLE_COUNTER(STAT_GDKServerEquip);
+
+	AckedEquipSequence = Sequence;
+
 	if (HasHoldableAtIndex(TargetIndex))
 	{
+		if (bDataOnlyInventory && TargetIndex != CurrentHeldIndex)
+		{
+			DematerializeSlot(CurrentHeldIndex);
+			MaterializeSlot(TargetIndex);
+		}
 		CurrentHeldIndex = TargetIndex;
 	}
 	OnRep_HeldUpdate();
 }
 
-bool UEquippedComponent::ServerRequestEquip_Validate(int32 TargetIndex)
+bool UEquippedComponent::ServerRequestEquip_Validate(int32 TargetIndex, int32 Sequence)
 {
 	return true;
 }
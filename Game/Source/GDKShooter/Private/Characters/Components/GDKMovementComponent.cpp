@@ -2,13 +2,40 @@
 
 #include "Characters/Components/GDKMovementComponent.h"
 
+#include "Engine/Player.h"
+#include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/GDKNetDriver.h"
 #include "Net/UnrealNetwork.h"
 #include "GDKLogging.h"
+#include "GDKStats.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Moves Sent Per Second"), STAT_GDKMovesSentPerSecond, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Move Upstream Bytes Per Second"), STAT_GDKMoveUpstreamBytesPerSecond, STATGROUP_GDKShooter);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Corrections Per Second"), STAT_GDKCorrectionsPerSecond, STATGROUP_GDKShooter);
+
+static FAutoConsoleCommandWithWorld MovementStatsCommand(
+	TEXT("GDK.Movement.Stats"),
+	TEXT("Logs the local player's move send rate, upstream and correction rate."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		const APlayerController* PlayerController = World != nullptr ? World->GetFirstPlayerController() : nullptr;
+		if (PlayerController != nullptr && PlayerController->GetPawn() != nullptr)
+		{
+			if (const UGDKMovementComponent* Movement = PlayerController->GetPawn()->FindComponentByClass<UGDKMovementComponent>())
+			{
+				Movement->LogMoveStats();
+			}
+		}
+	}));
 
 // Use the first custom movement flag slot in the character for sprinting.
 static const FSavedMove_Character::CompressedFlags FLAG_WantsToSprint = FSavedMove_GDKMovement::FLAG_Custom_0;
+// And the second for aiming, as it changes max speed and acceleration.
+static const FSavedMove_Character::CompressedFlags FLAG_IsAiming = FSavedMove_GDKMovement::FLAG_Custom_1;
 
 UGDKMovementComponent::UGDKMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -23,6 +50,11 @@ UGDKMovementComponent::UGDKMovementComponent(const FObjectInitializer& ObjectIni
 	, SprintAcceleration(3400)
 	, SprintDirectionTolerance(0.1f)
 	, JogAcceleration(1800)
+	, bAdaptiveMoveSendRate(true)
+	, LatencySensitiveSendDeltaTime(1.f / 60.f)
+	, ConstrainedSendDeltaTime(1.f / 30.f)
+	, MoveUpstreamBudget(2000.f)
+	, ConstrainedNetSpeed(10000)
 {
 	MaxWalkSpeed = 250;
 	MaxWalkSpeedCrouched = 125;
@@ -46,7 +78,7 @@ void UGDKMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UGDKMovementComponent, bIsAiming);
+	DOREPLIFETIME_CONDITION(UGDKMovementComponent, bIsAiming, COND_SkipOwner);
 }
 
 void UGDKMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
@@ -55,6 +87,18 @@ void UGDKMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
 
 	// Extract saved state from Flags and apply it to our local variables.
 	bWantsToSprint = (Flags & FLAG_WantsToSprint) != 0;
+
+	const bool bNewIsAiming = (Flags & FLAG_IsAiming) != 0;
+	if (bNewIsAiming != bIsAiming)
+	{
+		bIsAiming = bNewIsAiming;
+
+		// Moves replayed after a correction only restore state the owning client has already broadcast.
+		if (CharacterOwner == nullptr || !CharacterOwner->bClientUpdating)
+		{
+			OnAimingUpdated.Broadcast(bIsAiming);
+		}
+	}
 }
 
 class FNetworkPredictionData_Client* UGDKMovementComponent::GetPredictionData_Client() const
@@ -74,6 +118,55 @@ class FNetworkPredictionData_Client* UGDKMovementComponent::GetPredictionData_Cl
 	return ClientPredictionData;
 }
 
+float UGDKMovementComponent::GetClientNetSendDeltaTime(const APlayerController* PC, const FNetworkPredictionData_Client_Character* ClientData, const FSavedMovePtr& NewMove) const
+{
+	const float DefaultDeltaTime = Super::GetClientNetSendDeltaTime(PC, ClientData, NewMove);
+	if (!bAdaptiveMoveSendRate || ClientData == nullptr)
+	{
+		return DefaultDeltaTime;
+	}
+
+	return static_cast<const FNetworkPredictionData_Client_GDKMovement*>(ClientData)->GetAdaptiveSendDeltaTime(*this, PC, DefaultDeltaTime);
+}
+
+void UGDKMovementComponent::CallServerMove(const FSavedMove_Character* NewMove, const FSavedMove_Character* OldMove)
+{
+	// The payload of whichever ServerMove RPCs the engine picks, measured as it is sent.
+	UGDKNetDriver* NetDriver = Cast<UGDKNetDriver>(GetWorld()->GetNetDriver());
+	if (NetDriver != nullptr)
+	{
+		NetDriver->BeginMeasuringRpcBytes();
+	}
+
+	Super::CallServerMove(NewMove, OldMove);
+
+	const int32 Bytes = NetDriver != nullptr ? NetDriver->EndMeasuringRpcBytes() : 0;
+
+	// ServerMoveDual or ServerMoveDualHybridRootMotion when there is an old move to resend.
+	const int32 NumMoves = OldMove != nullptr ? 2 : 1;
+	static_cast<FNetworkPredictionData_Client_GDKMovement*>(GetPredictionData_Client())->RecordServerMove(NumMoves, Bytes, GetWorld()->GetTimeSeconds());
+}
+
+void UGDKMovementComponent::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode)
+{
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode);
+
+	static_cast<FNetworkPredictionData_Client_GDKMovement&>(ClientData).RecordCorrection(GetWorld()->GetTimeSeconds());
+}
+
+void UGDKMovementComponent::LogMoveStats() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UE_LOG(LogGDK, Log, TEXT("No moves sent by %s"), *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	const FNetworkPredictionData_Client_GDKMovement* GDKClientData = static_cast<const FNetworkPredictionData_Client_GDKMovement*>(ClientPredictionData);
+	UE_LOG(LogGDK, Log, TEXT("Moves sent: %.1f/s, upstream: %.0f bytes/s, corrections: %.2f/s"),
+		GDKClientData->MovesPerSecond, GDKClientData->UpstreamBytesPerSecond, GDKClientData->CorrectionsPerSecond);
+}
+
 void UGDKMovementComponent::SetSprintEnabled(bool bSprintEnabled)
 {
 	bCanSprint = bSprintEnabled;
@@ -164,6 +257,7 @@ void FSavedMove_GDKMovement::Clear()
 {
 	Super::Clear();
 	bSavedWantsToSprint = false;
+	bSavedIsAiming = false;
 }
 
 uint8 FSavedMove_GDKMovement::GetCompressedFlags() const
@@ -173,6 +267,10 @@ uint8 FSavedMove_GDKMovement::GetCompressedFlags() const
 	{
 		Result |= FLAG_WantsToSprint;
 	}
+	if (bSavedIsAiming)
+	{
+		Result |= FLAG_IsAiming;
+	}
 	return Result;
 }
 
@@ -182,6 +280,10 @@ bool FSavedMove_GDKMovement::CanCombineWith(const FSavedMovePtr& NewMove, AChara
 	{
 		return false;
 	}
+	if (bSavedIsAiming != ((FSavedMove_GDKMovement*)&NewMove)->bSavedIsAiming)
+	{
+		return false;
+	}
 	return Super::CanCombineWith(NewMove, InPawn, MaxDelta);
 }
 
@@ -193,11 +295,19 @@ void FSavedMove_GDKMovement::SetMoveFor(ACharacter* Character, float InDeltaTime
 	if (CharacterMovement)
 	{
 		bSavedWantsToSprint = CharacterMovement->bWantsToSprint;
+		bSavedIsAiming = CharacterMovement->bIsAiming;
 	}
 }
 
 FNetworkPredictionData_Client_GDKMovement::FNetworkPredictionData_Client_GDKMovement(const UCharacterMovementComponent& ClientMovement)
 	: Super(ClientMovement)
+	, MovesPerSecond(0.f)
+	, UpstreamBytesPerSecond(0.f)
+	, CorrectionsPerSecond(0.f)
+	, WindowStartTime(0.f)
+	, WindowMoves(0)
+	, WindowBytes(0)
+	, WindowCorrections(0)
 { }
 
 FSavedMovePtr FNetworkPredictionData_Client_GDKMovement::AllocateNewMove()
@@ -205,33 +315,71 @@ FSavedMovePtr FNetworkPredictionData_Client_GDKMovement::AllocateNewMove()
 	return FSavedMovePtr(new FSavedMove_GDKMovement());
 }
 
-bool UGDKMovementComponent::CanCrouchInCurrentState() const
+float FNetworkPredictionData_Client_GDKMovement::GetAdaptiveSendDeltaTime(const UGDKMovementComponent& Movement, const APlayerController* PC, float DefaultDeltaTime) const
 {
-	if (!CanEverCrouch())
+	// Firing and aiming are when corrections and late hits are most noticeable, so send every move.
+	if (Movement.IsAiming() || Movement.IsBusy())
 	{
-		return false;
+		return FMath::Min(DefaultDeltaTime, Movement.LatencySensitiveSendDeltaTime);
 	}
 
-	return !IsFalling() && IsMovingOnGround() && UpdatedComponent && !UpdatedComponent->IsSimulatingPhysics();
+	const bool bSlowConnection = PC != nullptr && PC->Player != nullptr && PC->Player->CurrentNetSpeed < Movement.ConstrainedNetSpeed;
+	if (bSlowConnection || UpstreamBytesPerSecond > Movement.MoveUpstreamBudget)
+	{
+		return FMath::Max(DefaultDeltaTime, Movement.ConstrainedSendDeltaTime);
+	}
+
+	return DefaultDeltaTime;
 }
 
-bool UGDKMovementComponent::ServerSetAiming_Validate(bool NewValue)
+void FNetworkPredictionData_Client_GDKMovement::RecordServerMove(int32 NumMoves, int32 Bytes, float Now)
 {
-	return true;
+	UpdateWindow(Now);
+	WindowMoves += NumMoves;
+	WindowBytes += Bytes;
 }
 
-void UGDKMovementComponent::ServerSetAiming_Implementation(bool NewValue)
+void FNetworkPredictionData_Client_GDKMovement::RecordCorrection(float Now)
 {
-	bIsAiming = NewValue;
+	UpdateWindow(Now);
+	WindowCorrections++;
 }
 
-void UGDKMovementComponent::SetAiming(bool NewValue)
+void FNetworkPredictionData_Client_GDKMovement::UpdateWindow(float Now)
 {
-	bIsAiming = NewValue;
-	if (GetOwnerRole() != ROLE_SimulatedProxy)
+	const float WindowLength = Now - WindowStartTime;
+	if (WindowLength < 1.f)
+	{
+		return;
+	}
+
+	MovesPerSecond = WindowMoves / WindowLength;
+	UpstreamBytesPerSecond = WindowBytes / WindowLength;
+	CorrectionsPerSecond = WindowCorrections / WindowLength;
+
+	SET_DWORD_STAT(STAT_GDKMovesSentPerSecond, FMath::RoundToInt(MovesPerSecond));
+	SET_DWORD_STAT(STAT_GDKMoveUpstreamBytesPerSecond, FMath::RoundToInt(UpstreamBytesPerSecond));
+	SET_FLOAT_STAT(STAT_GDKCorrectionsPerSecond, CorrectionsPerSecond);
+
+	WindowStartTime = Now;
+	WindowMoves = 0;
+	WindowBytes = 0;
+	WindowCorrections = 0;
+}
+
+bool UGDKMovementComponent::CanCrouchInCurrentState() const
+{
+	if (!CanEverCrouch())
 	{
-		ServerSetAiming(NewValue);
+		return false;
 	}
+
+	return !IsFalling() && IsMovingOnGround() && UpdatedComponent && !UpdatedComponent->IsSimulatingPhysics();
+}
+
+void UGDKMovementComponent::SetAiming(bool NewValue)
+{
+	bIsAiming = NewValue;
 	OnAimingUpdated.Broadcast(bIsAiming);
 }
 
@@ -1,12 +1,18 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #include "Characters/Components/HealthComponent.h"
+#include "Controllers/Components/ClientFXPoolComponent.h"
 #include "Controllers/Components/ControllerEventsComponent.h"
 #include "Game/Components/ScorePublisher.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
 #include "Characters/Components/TeamComponent.h"
+#include "GDKStats.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_CYCLE_STAT(TEXT("Take Damage"), STAT_GDKTakeDamage, STATGROUP_GDKShooter);
+
 UHealthComponent::UHealthComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -57,6 +63,8 @@ void UHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void UHealthComponent::TakeDamage(float Damage, const FDamageEvent& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	SCOPE_CYCLE_COUNTER(STAT_GDKTakeDamage);
+
 	if (UTeamComponent* Team = Cast<UTeamComponent>(GetOwner()->GetComponentByClass(UTeamComponent::StaticClass())))
 	{
 		if (EventInstigator && !Team->CanDamageActor(EventInstigator->GetPawn()))
@@ -166,6 +174,18 @@ void UHealthComponent::TakeDamage(float Damage, const FDamageEvent& DamageEvent,
 	}
 }
 
+void UHealthComponent::ResetHealth()
+{
+	GetOwner()->GetWorldTimerManager().ClearTimer(HealthRegenerationHandle);
+	GetOwner()->GetWorldTimerManager().ClearTimer(ArmourRegenerationHandle);
+
+	CurrentHealth = MaxHealth;
+	CurrentArmour = 0.f;
+
+	HealthUpdated.Broadcast(CurrentHealth, MaxHealth);
+	ArmourUpdated.Broadcast(CurrentArmour, MaxArmour);
+}
+
 bool UHealthComponent::GrantHealth(float Value)
 {
 	if (CurrentHealth < MaxHealth)
@@ -223,4 +243,17 @@ void UHealthComponent::OnRep_CurrentHealth()
 void UHealthComponent::MulticastDamageTaken_Implementation(float Value, FVector Source, FVector Impact, int32 InstigatorPlayerId, FGenericTeamId InstigatorTeamId)
 {
 	DamageTaken.Broadcast(Value, Source, Impact, InstigatorPlayerId, InstigatorTeamId);
+
+	// [client] Damage the local player dealt pops up where it landed, from the pool rather than a new actor per hit.
+	UClientFXPoolComponent* FXPool = InstigatorPlayerId >= 0 ? UClientFXPoolComponent::Get(this) : nullptr;
+	if (FXPool == nullptr)
+	{
+		return;
+	}
+
+	const APlayerState* LocalPlayerState = CastChecked<APlayerController>(FXPool->GetOwner())->PlayerState;
+	if (LocalPlayerState != nullptr && LocalPlayerState->PlayerId == InstigatorPlayerId)
+	{
+		FXPool->ShowDamageNumber(Impact, Value, FLinearColor::White);
+	}
 }
@@ -4,6 +4,7 @@
 #include "Net/UnrealNetwork.h"
 
 #include "Engine/World.h"
+#include "Game/Components/PerceptionRegistryComponent.h"
 
 
 UTeamComponent::UTeamComponent()
@@ -19,6 +20,19 @@ void UTeamComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLi
 	DOREPLIFETIME(UTeamComponent, TeamId);
 }
 
+void UTeamComponent::SetTeam(FGenericTeamId NewTeamId)
+{
+	TeamId = NewTeamId;
+
+	if (GetOwner()->HasAuthority())
+	{
+		if (UPerceptionRegistryComponent* PerceptionRegistry = UPerceptionRegistryComponent::Get(this))
+		{
+			PerceptionRegistry->UpdateTeam(GetOwner(), NewTeamId);
+		}
+	}
+}
+
 bool UTeamComponent::CanDamageActor(AActor* OtherActor)
 {
 	if (!IsValid(OtherActor))
@@ -10,6 +10,12 @@
 #include "GDKLogging.h"
 #include "Controllers/GDKPlayerController.h"
 #include "Controllers/Components/ControllerEventsComponent.h"
+#include "Game/Components/CharacterPoolComponent.h"
+#include "Game/Components/LineOfSightServiceComponent.h"
+#include "Game/Components/NPCSignificanceComponent.h"
+#include "Game/Components/PerceptionRegistryComponent.h"
+#include "Game/Components/SpawnSelectorComponent.h"
+#include "Phases/PhaseManagerComponent.h"
 #include "Weapons/Holdable.h"
 
 AGDKCharacter::AGDKCharacter(const FObjectInitializer& ObjectInitializer)
@@ -23,6 +29,15 @@ AGDKCharacter::AGDKCharacter(const FObjectInitializer& ObjectInitializer)
 	MetaDataComponent = CreateDefaultSubobject<UMetaDataComponent>(TEXT("MetaData"));
 	TeamComponent = CreateDefaultSubobject<UTeamComponent>(TEXT("Team"));
 	GDKMovementComponent = Cast<UGDKMovementComponent>(GetCharacterMovement());
+
+	PoolGeneration = 0;
+}
+
+void AGDKCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AGDKCharacter, PoolGeneration);
 }
 
 // Called when the game starts or when spawned
@@ -32,6 +47,61 @@ void AGDKCharacter::BeginPlay()
 
 	EquippedComponent->HoldableUpdated.AddDynamic(this, &AGDKCharacter::OnEquippedUpdated);
 	GDKMovementComponent->SprintingUpdated.AddDynamic(EquippedComponent, &UEquippedComponent::SetIsSprinting);
+
+	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+	MeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+	MeshCollisionEnabled = GetMesh()->GetCollisionEnabled();
+	CapsuleCollisionEnabled = GetCapsuleComponent()->GetCollisionEnabled();
+
+	// Every server worker tracks the characters it sees, not only the ones it is authoritative over,
+	// so characters handed over to it are already known and others' positions are taken into account.
+	if (GetNetMode() != NM_Client)
+	{
+		if (USpawnSelectorComponent* SpawnSelector = USpawnSelectorComponent::Get(this))
+		{
+			SpawnSelector->RegisterCharacter(this);
+		}
+
+		if (UNPCSignificanceComponent* NPCSignificance = UNPCSignificanceComponent::Get(this))
+		{
+			NPCSignificance->RegisterCharacter(this);
+		}
+
+		if (UPerceptionRegistryComponent* PerceptionRegistry = UPerceptionRegistryComponent::Get(this))
+		{
+			PerceptionRegistry->RegisterActor(this);
+		}
+
+		if (UPhaseManagerComponent* PhaseManager = UPhaseManagerComponent::Get(this))
+		{
+			PhaseManager->RegisterCharacter(this);
+		}
+	}
+}
+
+void AGDKCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USpawnSelectorComponent* SpawnSelector = USpawnSelectorComponent::Get(this))
+	{
+		SpawnSelector->UnregisterCharacter(this);
+	}
+
+	if (UNPCSignificanceComponent* NPCSignificance = UNPCSignificanceComponent::Get(this))
+	{
+		NPCSignificance->UnregisterCharacter(this);
+	}
+
+	if (UPerceptionRegistryComponent* PerceptionRegistry = UPerceptionRegistryComponent::Get(this))
+	{
+		PerceptionRegistry->UnregisterActor(this);
+	}
+
+	if (UPhaseManagerComponent* PhaseManager = UPhaseManagerComponent::Get(this))
+	{
+		PhaseManager->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AGDKCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -61,16 +131,16 @@ void AGDKCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompon
 	PlayerInputComponent->BindAction("Secondary", IE_Pressed, EquippedComponent, &UEquippedComponent::StartSecondaryUse);
 	PlayerInputComponent->BindAction("Secondary", IE_Released, EquippedComponent, &UEquippedComponent::StopSecondaryUse);
 
-	PlayerInputComponent->BindAction< FHoldableSelection>("1", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 0);
-	PlayerInputComponent->BindAction< FHoldableSelection>("2", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 1);
-	PlayerInputComponent->BindAction< FHoldableSelection>("3", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 2);
-	PlayerInputComponent->BindAction< FHoldableSelection>("4", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 3);
-	PlayerInputComponent->BindAction< FHoldableSelection>("5", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 4);
-	PlayerInputComponent->BindAction< FHoldableSelection>("6", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 5);
-	PlayerInputComponent->BindAction< FHoldableSelection>("7", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 6);
-	PlayerInputComponent->BindAction< FHoldableSelection>("8", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 7);
-	PlayerInputComponent->BindAction< FHoldableSelection>("9", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 8);
-	PlayerInputComponent->BindAction< FHoldableSelection>("0", IE_Pressed, EquippedComponent, &UEquippedComponent::ServerRequestEquip, 9);
+	PlayerInputComponent->BindAction< FHoldableSelection>("1", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 0);
+	PlayerInputComponent->BindAction< FHoldableSelection>("2", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 1);
+	PlayerInputComponent->BindAction< FHoldableSelection>("3", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 2);
+	PlayerInputComponent->BindAction< FHoldableSelection>("4", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 3);
+	PlayerInputComponent->BindAction< FHoldableSelection>("5", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 4);
+	PlayerInputComponent->BindAction< FHoldableSelection>("6", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 5);
+	PlayerInputComponent->BindAction< FHoldableSelection>("7", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 6);
+	PlayerInputComponent->BindAction< FHoldableSelection>("8", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 7);
+	PlayerInputComponent->BindAction< FHoldableSelection>("9", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 8);
+	PlayerInputComponent->BindAction< FHoldableSelection>("0", IE_Pressed, EquippedComponent, &UEquippedComponent::RequestEquip, 9);
 	PlayerInputComponent->BindAction("QuickToggle", IE_Pressed, EquippedComponent, &UEquippedComponent::QuickToggle);
 	PlayerInputComponent->BindAction("ToggleMode", IE_Pressed, EquippedComponent, &UEquippedComponent::ToggleMode);
 	PlayerInputComponent->BindAction("ScrollUp", IE_Pressed, EquippedComponent, &UEquippedComponent::ScrollUp);
@@ -131,6 +201,7 @@ void AGDKCharacter::StartRagdoll_Implementation()
 		if (Component != nullptr && Component != MeshComponent)
 		{
 			ComponentsToMove.Add(Component);
+			RagdollMovedComponents.Emplace(Component, Component->GetRelativeTransform());
 		}
 	}
 
@@ -150,8 +221,89 @@ void AGDKCharacter::StartRagdoll_Implementation()
 }
 
 
+void AGDKCharacter::StopRagdoll()
+{
+	UCapsuleComponent* Capsule = GetCapsuleComponent();
+	USkeletalMeshComponent* MeshComponent = GetMesh();
+	if (Capsule == nullptr || GetRootComponent() == Capsule)
+	{
+		return;
+	}
+
+	MeshComponent->SetSimulatePhysics(false);
+	MeshComponent->SetCollisionProfileName(MeshCollisionProfile);
+	MeshComponent->SetCollisionEnabled(MeshCollisionEnabled);
+
+	Capsule->SetWorldLocation(MeshComponent->GetComponentLocation());
+	SetRootComponent(Capsule);
+	MeshComponent->AttachToComponent(Capsule, FAttachmentTransformRules::KeepRelativeTransform);
+	MeshComponent->SetRelativeTransform(MeshRelativeTransform);
+
+	for (const TPair<TWeakObjectPtr<USceneComponent>, FTransform>& Moved : RagdollMovedComponents)
+	{
+		if (USceneComponent* Component = Moved.Key.Get())
+		{
+			Component->AttachToComponent(Capsule, FAttachmentTransformRules::KeepRelativeTransform);
+			Component->SetRelativeTransform(Moved.Value);
+		}
+	}
+	RagdollMovedComponents.Reset();
+
+	Capsule->SetCollisionEnabled(CapsuleCollisionEnabled);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+}
+
+void AGDKCharacter::OnRep_PoolGeneration()
+{
+	StopRagdoll();
+}
+
+void AGDKCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	GetWorldTimerManager().ClearTimer(DeletionTimer);
+	StopRagdoll();
+	PoolGeneration++;
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	HealthComponent->ResetHealth();
+	TeamComponent->SetTeam(FGenericTeamId::NoTeam);
+	EquippedComponent->ResetToStarterTemplates();
+}
+
+void AGDKCharacter::ParkInPool(const FVector& ParkingLocation)
+{
+	if (AController* OldController = GetController())
+	{
+		OldController->UnPossess();
+	}
+
+	GetWorldTimerManager().ClearTimer(DeletionTimer);
+	StopRagdoll();
+	PoolGeneration++;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	GetCharacterMovement()->DisableMovement();
+	SetActorLocation(ParkingLocation, false, nullptr, ETeleportType::ResetPhysics);
+}
+
 void AGDKCharacter::DeleteSelf()
 {
+	if (HasAuthority())
+	{
+		if (UCharacterPoolComponent* CharacterPool = UCharacterPoolComponent::Get(this))
+		{
+			if (CharacterPool->Release(this))
+			{
+				return;
+			}
+		}
+	}
+
 	if (this->IsValidLowLevel())
 	{
 		this->Destroy();
@@ -169,6 +321,10 @@ void AGDKCharacter::TakeDamageCrossServer_Implementation(float Damage, const FDa
 	float ActualDamage = Super::TakeDamage(Damage, DamageEvent, EventInstigator, DamageCauser);
 	HealthComponent->TakeDamage(ActualDamage, DamageEvent, EventInstigator, DamageCauser);
 
+	if (UNPCSignificanceComponent* NPCSignificance = UNPCSignificanceComponent::Get(this))
+	{
+		NPCSignificance->NotifyDamaged(this);
+	}
 }
 
 FGenericTeamId AGDKCharacter::GetGenericTeamId() const
@@ -185,6 +341,19 @@ bool AGDKCharacter::CanBeSeenFrom(const FVector& ObserverLocation, FVector& OutS
 		return 0;
 	}
 
+	if (ULineOfSightServiceComponent* LineOfSightService = ULineOfSightServiceComponent::Get(this))
+	{
+		TArray<FVector> TargetPoints;
+		TargetPoints.Reserve(LineOfSightSockets.Num());
+		for (const FName& Socket : LineOfSightSockets)
+		{
+			TargetPoints.Add(GetMesh()->GetSocketLocation(Socket));
+		}
+
+		return LineOfSightService->CanBeSeenFrom(this, TargetPoints, LineOfSightCollisionChannel.GetValue(), ObserverLocation,
+			OutSeenLocation, NumberOfLoSChecksPerformed, OutSightStrength, IgnoreActor);
+	}
+
 	bool bHasSeen = false;
 
 	for (int i = 0; i < LineOfSightSockets.Num(); i++)
@@ -0,0 +1,391 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Controllers/Components/ClientFXPoolComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/TextRenderComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GDKStats.h"
+#include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Pool Damage Numbers Active"), STAT_GDKFXPoolDamageNumbersActive, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Pool Damage Numbers Pooled"), STAT_GDKFXPoolDamageNumbersPooled, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Pool Impacts Active"), STAT_GDKFXPoolImpactsActive, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Pool Impacts Pooled"), STAT_GDKFXPoolImpactsPooled, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Pool Queued"), STAT_GDKFXPoolQueued, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Pool Started"), STAT_GDKFXPoolStarted, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Pool Culled"), STAT_GDKFXPoolCulled, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Pool Merged"), STAT_GDKFXPoolMerged, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Pool Recycled In Use"), STAT_GDKFXPoolRecycledInUse, STATGROUP_GDKShooter);
+
+UClientFXPoolComponent::UClientFXPoolComponent()
+	: SpawnBudgetPerFrame(4)
+	, CullDistance(8000.f)
+	, MergeRadius(50.f)
+	, MergeWindow(0.2f)
+	, MaxDamageNumbers(32)
+	, DamageNumberLifetime(1.f)
+	, DamageNumberRiseSpeed(100.f)
+	, DamageNumberSize(24.f)
+	, DamageNumberMaterial(nullptr)
+	, MaxImpacts(32)
+	, FXActor(nullptr)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+UClientFXPoolComponent* UClientFXPoolComponent::Get(const UObject* WorldContextObject)
+{
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(WorldContextObject, 0);
+	if (PlayerController == nullptr || !PlayerController->IsLocalController())
+	{
+		return nullptr;
+	}
+
+	return PlayerController->FindComponentByClass<UClientFXPoolComponent>();
+}
+
+void UClientFXPoolComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (PlayerController == nullptr || !PlayerController->IsLocalController())
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	FXActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (FXActor == nullptr)
+	{
+		return;
+	}
+	FXActor->SetReplicates(false);
+
+	SetComponentTickEnabled(true);
+}
+
+void UClientFXPoolComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UObject* Object : PooledObjects)
+	{
+		if (UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			Component->DestroyComponent();
+		}
+	}
+	PooledObjects.Empty();
+	if (FXActor != nullptr)
+	{
+		FXActor->Destroy();
+		FXActor = nullptr;
+	}
+	DamageNumberSlots.Empty();
+	ImpactSlots.Empty();
+	PendingDamageNumbers.Empty();
+	PendingImpacts.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UClientFXPoolComponent::GetCameraLocation(FVector& OutLocation) const
+{
+	const APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr)
+	{
+		return false;
+	}
+
+	OutLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
+
+bool UClientFXPoolComponent::ShouldCull(const FVector& Location) const
+{
+	if (FXActor == nullptr)
+	{
+		return true;
+	}
+
+	// Read now rather than on tick, so effects requested before the first tick aren't culled against the origin.
+	FVector CameraLocation;
+	return GetCameraLocation(CameraLocation) && FVector::DistSquared(Location, CameraLocation) > FMath::Square(CullDistance);
+}
+
+void UClientFXPoolComponent::ShowDamageNumber(FVector Location, float Damage, FLinearColor Color)
+{
+	if (ShouldCull(Location))
+	{
+		INC_DWORD_STAT(STAT_GDKFXPoolCulled);
+		return;
+	}
+
+	const float MergeRadiusSquared = FMath::Square(MergeRadius);
+	for (FPendingDamageNumber& Pending : PendingDamageNumbers)
+	{
+		if (FVector::DistSquared(Pending.Location, Location) <= MergeRadiusSquared)
+		{
+			INC_DWORD_STAT(STAT_GDKFXPoolMerged);
+			Pending.Damage += Damage;
+			return;
+		}
+	}
+
+	for (FDamageNumberSlot& Slot : DamageNumberSlots)
+	{
+		if (Slot.bActive && Slot.Age <= MergeWindow && FVector::DistSquared(Slot.StartLocation, Location) <= MergeRadiusSquared)
+		{
+			INC_DWORD_STAT(STAT_GDKFXPoolMerged);
+			Slot.Damage += Damage;
+			Slot.Text->SetText(FText::AsNumber(FMath::RoundToInt(Slot.Damage)));
+			return;
+		}
+	}
+
+	// Nothing in the queue waits longer than a full pool would take to show.
+	if (PendingDamageNumbers.Num() >= MaxDamageNumbers)
+	{
+		INC_DWORD_STAT(STAT_GDKFXPoolCulled);
+		PendingDamageNumbers.RemoveAt(0, 1, false);
+	}
+
+	PendingDamageNumbers.Add({ Location, Damage, Color });
+}
+
+void UClientFXPoolComponent::ShowImpact(UParticleSystem* Template, FVector Location, FRotator Rotation)
+{
+	if (Template == nullptr)
+	{
+		return;
+	}
+
+	if (ShouldCull(Location))
+	{
+		INC_DWORD_STAT(STAT_GDKFXPoolCulled);
+		return;
+	}
+
+	const float MergeRadiusSquared = FMath::Square(MergeRadius);
+	for (const FPendingImpact& Pending : PendingImpacts)
+	{
+		if (Pending.Template == Template && FVector::DistSquared(Pending.Location, Location) <= MergeRadiusSquared)
+		{
+			INC_DWORD_STAT(STAT_GDKFXPoolMerged);
+			return;
+		}
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (const FImpactSlot& Slot : ImpactSlots)
+	{
+		if (Slot.Emitter->IsActive() && Now - Slot.StartTime <= MergeWindow && Slot.Emitter->Template == Template
+			&& FVector::DistSquared(Slot.Emitter->GetComponentLocation(), Location) <= MergeRadiusSquared)
+		{
+			INC_DWORD_STAT(STAT_GDKFXPoolMerged);
+			return;
+		}
+	}
+
+	if (PendingImpacts.Num() >= MaxImpacts)
+	{
+		INC_DWORD_STAT(STAT_GDKFXPoolCulled);
+		PendingImpacts.RemoveAt(0, 1, false);
+	}
+
+	PendingImpacts.Add({ Template, Location, Rotation });
+}
+
+void UClientFXPoolComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FVector CameraLocation = FVector::ZeroVector;
+	GetCameraLocation(CameraLocation);
+
+	// Take turns between the queues so a burst of one kind doesn't hold up the other.
+	int32 NumDamageNumbers = 0;
+	int32 NumImpacts = 0;
+	for (int32 Budget = SpawnBudgetPerFrame; Budget > 0; )
+	{
+		const int32 BudgetBefore = Budget;
+		if (NumDamageNumbers < PendingDamageNumbers.Num())
+		{
+			StartDamageNumber(PendingDamageNumbers[NumDamageNumbers++], CameraLocation);
+			Budget--;
+		}
+		if (Budget > 0 && NumImpacts < PendingImpacts.Num())
+		{
+			StartImpact(PendingImpacts[NumImpacts++]);
+			Budget--;
+		}
+		if (Budget == BudgetBefore)
+		{
+			break;
+		}
+	}
+	PendingDamageNumbers.RemoveAt(0, NumDamageNumbers, false);
+	PendingImpacts.RemoveAt(0, NumImpacts, false);
+
+	UpdateDamageNumbers(DeltaTime, CameraLocation);
+
+#if STATS
+	int32 ActiveImpacts = 0;
+	for (const FImpactSlot& Slot : ImpactSlots)
+	{
+		ActiveImpacts += Slot.Emitter->IsActive() ? 1 : 0;
+	}
+	SET_DWORD_STAT(STAT_GDKFXPoolImpactsActive, ActiveImpacts);
+	SET_DWORD_STAT(STAT_GDKFXPoolImpactsPooled, ImpactSlots.Num());
+	SET_DWORD_STAT(STAT_GDKFXPoolDamageNumbersPooled, DamageNumberSlots.Num());
+	SET_DWORD_STAT(STAT_GDKFXPoolQueued, PendingDamageNumbers.Num() + PendingImpacts.Num());
+#endif
+}
+
+void UClientFXPoolComponent::UpdateDamageNumbers(float DeltaTime, const FVector& CameraLocation)
+{
+	const float FadeRate = DamageNumberLifetime > 0.f ? 1.f / DamageNumberLifetime : 1.f;
+
+	int32 ActiveDamageNumbers = 0;
+	for (FDamageNumberSlot& Slot : DamageNumberSlots)
+	{
+		if (!Slot.bActive)
+		{
+			continue;
+		}
+
+		Slot.Age += DeltaTime;
+		if (Slot.Age >= DamageNumberLifetime)
+		{
+			Slot.bActive = false;
+			Slot.Text->SetVisibility(false);
+			continue;
+		}
+
+		ActiveDamageNumbers++;
+		const FVector Location = Slot.StartLocation + FVector(0.f, 0.f, DamageNumberRiseSpeed * Slot.Age);
+		Slot.Text->SetWorldLocationAndRotation(Location, (CameraLocation - Location).Rotation());
+		if (Slot.Material != nullptr)
+		{
+			Slot.Material->SetScalarParameterValue(DamageNumberFadeParameter, 1.f - Slot.Age * FadeRate);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_GDKFXPoolDamageNumbersActive, ActiveDamageNumbers);
+}
+
+void UClientFXPoolComponent::StartDamageNumber(const FPendingDamageNumber& Pending, const FVector& CameraLocation)
+{
+	INC_DWORD_STAT(STAT_GDKFXPoolStarted);
+
+	FDamageNumberSlot& Slot = AcquireDamageNumberSlot();
+	Slot.StartLocation = Pending.Location;
+	Slot.Damage = Pending.Damage;
+	Slot.Age = 0.f;
+	Slot.bActive = true;
+
+	Slot.Text->SetText(FText::AsNumber(FMath::RoundToInt(Pending.Damage)));
+	Slot.Text->SetTextRenderColor(Pending.Color.ToFColor(true));
+	Slot.Text->SetWorldLocationAndRotation(Pending.Location, (CameraLocation - Pending.Location).Rotation());
+	Slot.Text->SetVisibility(true);
+}
+
+void UClientFXPoolComponent::StartImpact(const FPendingImpact& Pending)
+{
+	INC_DWORD_STAT(STAT_GDKFXPoolStarted);
+
+	FImpactSlot& Slot = AcquireImpactSlot();
+	Slot.StartTime = GetWorld()->GetTimeSeconds();
+
+	if (Slot.Emitter->Template != Pending.Template)
+	{
+		Slot.Emitter->SetTemplate(Pending.Template);
+	}
+	Slot.Emitter->SetWorldLocationAndRotation(Pending.Location, Pending.Rotation);
+	Slot.Emitter->ActivateSystem(true);
+}
+
+UClientFXPoolComponent::FDamageNumberSlot& UClientFXPoolComponent::AcquireDamageNumberSlot()
+{
+	int32 OldestIndex = INDEX_NONE;
+	for (int32 i = 0; i < DamageNumberSlots.Num(); i++)
+	{
+		if (!DamageNumberSlots[i].bActive)
+		{
+			return DamageNumberSlots[i];
+		}
+		if (OldestIndex == INDEX_NONE || DamageNumberSlots[i].Age > DamageNumberSlots[OldestIndex].Age)
+		{
+			OldestIndex = i;
+		}
+	}
+
+	if (DamageNumberSlots.Num() >= FMath::Max(MaxDamageNumbers, 1))
+	{
+		INC_DWORD_STAT(STAT_GDKFXPoolRecycledInUse);
+		return DamageNumberSlots[OldestIndex];
+	}
+
+	UTextRenderComponent* Text = NewObject<UTextRenderComponent>(FXActor);
+	Text->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Text->SetCastShadow(false);
+	Text->SetHorizontalAlignment(EHTA_Center);
+	Text->SetVerticalAlignment(EVRTA_TextCenter);
+	Text->SetWorldSize(DamageNumberSize);
+	Text->SetVisibility(false);
+	Text->RegisterComponent();
+	PooledObjects.Add(Text);
+
+	FDamageNumberSlot& Slot = DamageNumberSlots.AddDefaulted_GetRef();
+	Slot.Text = Text;
+	if (DamageNumberMaterial != nullptr)
+	{
+		if (DamageNumberFadeParameter.IsNone())
+		{
+			Text->SetTextMaterial(DamageNumberMaterial);
+		}
+		else
+		{
+			Slot.Material = UMaterialInstanceDynamic::Create(DamageNumberMaterial, Text);
+			Text->SetTextMaterial(Slot.Material);
+		}
+	}
+	return Slot;
+}
+
+UClientFXPoolComponent::FImpactSlot& UClientFXPoolComponent::AcquireImpactSlot()
+{
+	int32 OldestIndex = INDEX_NONE;
+	for (int32 i = 0; i < ImpactSlots.Num(); i++)
+	{
+		if (!ImpactSlots[i].Emitter->IsActive())
+		{
+			return ImpactSlots[i];
+		}
+		if (OldestIndex == INDEX_NONE || ImpactSlots[i].StartTime < ImpactSlots[OldestIndex].StartTime)
+		{
+			OldestIndex = i;
+		}
+	}
+
+	if (ImpactSlots.Num() >= FMath::Max(MaxImpacts, 1))
+	{
+		INC_DWORD_STAT(STAT_GDKFXPoolRecycledInUse);
+		return ImpactSlots[OldestIndex];
+	}
+
+	UParticleSystemComponent* Emitter = NewObject<UParticleSystemComponent>(FXActor);
+	Emitter->bAutoActivate = false;
+	Emitter->bAutoDestroy = false;
+	Emitter->RegisterComponent();
+	PooledObjects.Add(Emitter);
+
+	FImpactSlot& Slot = ImpactSlots.AddDefaulted_GetRef();
+	Slot.Emitter = Emitter;
+	return Slot;
+}
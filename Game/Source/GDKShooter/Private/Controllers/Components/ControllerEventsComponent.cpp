@@ -1,6 +1,7 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #include "Controllers/Components/ControllerEventsComponent.h"
+#include "Game/Components/PlayerNameTableComponent.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/PlayerState.h"
 
@@ -19,11 +20,11 @@ void UControllerEventsComponent::Death_Implementation(const AController* Killer)
 		APlayerState* KillerPlayerState = Killer->PlayerState;
 		if (KillerPlayerState != nullptr)
 		{
-			ClientInformOfDeath(KillerPlayerState->GetPlayerName(), KillerPlayerState->PlayerId);
+			ClientInformOfDeath(KillerPlayerState->PlayerId);
 		}
 		else
 		{
-			ClientInformOfDeath(TEXT("") /*PlayerName*/, -1 /*PlayerID*/);
+			ClientInformOfDeath(-1 /*PlayerID*/);
 		}
 	}
 }
@@ -37,17 +38,17 @@ void UControllerEventsComponent::Kill_Implementation(const AController* Victim)
 		APlayerState* VictimPlayerState = Victim->PlayerState;
 		if (VictimPlayerState != nullptr)
 		{
-			ClientInformOfKill(VictimPlayerState->GetPlayerName(), VictimPlayerState->PlayerId);
+			ClientInformOfKill(VictimPlayerState->PlayerId);
 		}
 	}
 }
 
-void UControllerEventsComponent::ClientInformOfKill_Implementation(const FString& VictimName, int32 VictimId)
+void UControllerEventsComponent::ClientInformOfKill_Implementation(int32 VictimId)
 {
-	KillDetailsEvent.Broadcast(VictimName, VictimId);
+	KillDetailsEvent.Broadcast(UPlayerNameTableComponent::ResolvePlayerName(this, VictimId), VictimId);
 }
 
-void UControllerEventsComponent::ClientInformOfDeath_Implementation(const FString& KillerName, int32 KillerId)
+void UControllerEventsComponent::ClientInformOfDeath_Implementation(int32 KillerId)
 {
-	DeathDetailsEvent.Broadcast(KillerName, KillerId);
+	DeathDetailsEvent.Broadcast(UPlayerNameTableComponent::ResolvePlayerName(this, KillerId), KillerId);
 }
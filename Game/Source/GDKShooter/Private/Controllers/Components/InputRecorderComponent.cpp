@@ -0,0 +1,175 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Controllers/Components/InputRecorderComponent.h"
+#include "Characters/Components/EquippedComponent.h"
+#include "Characters/Components/GDKMovementComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "GDKLogging.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Weapons/Holdable.h"
+
+// "GDIR", followed by a version which must be bumped whenever the layout below changes.
+static const uint32 RecordingMagic = 0x52494447;
+static const uint32 RecordingVersion = 1;
+
+bool FInputRecording::Serialize(FArchive& Ar)
+{
+	uint32 Magic = RecordingMagic;
+	uint32 Version = RecordingVersion;
+	Ar << Magic << Version;
+	if (Magic != RecordingMagic || Version != RecordingVersion)
+	{
+		return false;
+	}
+
+	Ar << PlayerName;
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	if (NumFrames < 0 || Ar.IsError())
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		Frames.SetNum(NumFrames);
+	}
+
+	for (FRecordedInputFrame& Frame : Frames)
+	{
+		Ar << Frame.Time << Frame.Location << Frame.MovementInput << Frame.ControlRotation << Frame.HeldIndex << Frame.Flags;
+	}
+
+	return !Ar.IsError();
+}
+
+bool FInputRecording::SaveToFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Serialize(Writer);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FInputRecording::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	return Serialize(Reader);
+}
+
+UInputRecorderComponent::UInputRecorderComponent()
+	: StartTime(0.f)
+	, bStarted(false)
+{
+	// Every player controller has a recorder, so only register a tick function when recording was asked for.
+	PrimaryComponentTick.bCanEverTick = FParse::Param(FCommandLine::Get(), TEXT("RecordInput"));
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	// After movement has consumed this frame's input.
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UInputRecorderComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const APlayerController* Controller = Cast<APlayerController>(GetOwner());
+	if (PrimaryComponentTick.bCanEverTick && Controller != nullptr && Controller->IsLocalController())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UInputRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Recording.Frames.Num() > 0)
+	{
+		const APlayerController* Controller = Cast<APlayerController>(GetOwner());
+		Recording.PlayerName = Controller->PlayerState != nullptr ? Controller->PlayerState->GetPlayerName() : Controller->GetName();
+
+		const FString FileName = FPaths::MakeValidFileName(FString::Printf(TEXT("%s-%s.input"), *Recording.PlayerName, *FDateTime::Now().ToString()));
+		const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("InputRecordings"), FileName);
+
+		if (Recording.SaveToFile(Path))
+		{
+			UE_LOG(LogGDK, Log, TEXT("Wrote %d frames of input to %s"), Recording.Frames.Num(), *Path);
+		}
+		else
+		{
+			UE_LOG(LogGDK, Warning, TEXT("Failed to write input recording to %s"), *Path);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInputRecorderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const APawn* Pawn = Cast<APlayerController>(GetOwner())->GetPawn();
+
+	// Start with the first pawn, so the replay doesn't sit through the lobby.
+	if (!bStarted)
+	{
+		if (Pawn == nullptr)
+		{
+			return;
+		}
+
+		bStarted = true;
+		StartTime = GetWorld()->GetTimeSeconds();
+	}
+
+	CaptureFrame(Pawn);
+}
+
+void UInputRecorderComponent::CaptureFrame(const APawn* Pawn)
+{
+	FRecordedInputFrame& Frame = Recording.Frames.AddDefaulted_GetRef();
+	Frame.Time = GetWorld()->GetTimeSeconds() - StartTime;
+	Frame.ControlRotation = Cast<APlayerController>(GetOwner())->GetControlRotation();
+
+	if (Pawn == nullptr)
+	{
+		return;
+	}
+
+	Frame.Flags |= FRecordedInputFrame::HasPawn;
+	Frame.Location = Pawn->GetActorLocation();
+	Frame.MovementInput = Pawn->GetLastMovementInputVector();
+
+	if (const ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		Frame.Flags |= Character->bPressedJump ? FRecordedInputFrame::Jump : 0;
+		Frame.Flags |= Character->bIsCrouched ? FRecordedInputFrame::Crouch : 0;
+	}
+
+	if (const UGDKMovementComponent* Movement = Cast<UGDKMovementComponent>(Pawn->GetMovementComponent()))
+	{
+		Frame.Flags |= Movement->IsSprinting() ? FRecordedInputFrame::Sprint : 0;
+		Frame.Flags |= Movement->IsAiming() ? FRecordedInputFrame::Aim : 0;
+	}
+
+	if (const UEquippedComponent* Equipped = Pawn->FindComponentByClass<UEquippedComponent>())
+	{
+		Frame.HeldIndex = Equipped->GetEffectiveHeldIndex();
+
+		const AHoldable* Held = Equipped->CurrentlyHeldItem();
+		Frame.Flags |= Held != nullptr && Held->IsPrimaryInUse() ? FRecordedInputFrame::PrimaryUse : 0;
+	}
+}
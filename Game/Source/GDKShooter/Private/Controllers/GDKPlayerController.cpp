@@ -4,13 +4,17 @@
 
 #include "Blueprint/UserWidget.h"
 #include "Camera/CameraComponent.h"
+#include "Controllers/Components/ClientFXPoolComponent.h"
 #include "Controllers/Components/ControllerEventsComponent.h"
+#include "Controllers/Components/InputRecorderComponent.h"
 #include "Characters/Components/EquippedComponent.h"
 #include "Characters/Components/HealthComponent.h"
 #include "Characters/Components/MetaDataComponent.h"
 #include "EngineClasses/SpatialNetDriver.h"
 #include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Game/Components/PlayerNameTableComponent.h"
 #include "Game/Components/ScorePublisher.h"
+#include "Game/Components/SpawnLatencyTrackerComponent.h"
 #include "Game/Components/SpawnRequestPublisher.h"
 #include "Game/Components/PlayerPublisher.h"
 #include "GameFramework/Character.h"
@@ -27,6 +31,8 @@
 AGDKPlayerController::AGDKPlayerController()
 	: bIgnoreActionInput(false)
 	, DeleteCharacterDelay(5.0f)
+	, LastSpawnRequestTime(0.f)
+	, LastMeasuredSpawnRequestTime(0.f)
 {
 	// Don't automatically switch the camera view when the pawn changes, to avoid weird camera jumps when a character dies.
 	bAutoManageActiveCameraTarget = false;
@@ -42,6 +48,15 @@ AGDKPlayerController::AGDKPlayerController()
 	DeathCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	DeathCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
+	InputRecorder = CreateDefaultSubobject<UInputRecorderComponent>(TEXT("InputRecorder"));
+	FXPool = CreateDefaultSubobject<UClientFXPoolComponent>(TEXT("FXPool"));
+}
+
+void AGDKPlayerController::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(AGDKPlayerController, LastSpawnRequestTime, COND_OwnerOnly);
 }
 
 void AGDKPlayerController::Tick(float DeltaTime)
@@ -58,6 +73,19 @@ void AGDKPlayerController::SetPawn(APawn* InPawn)
 {
 	Super::SetPawn(InPawn);
 
+	if (InPawn != nullptr)
+	{
+		if (HasAuthority())
+		{
+			USpawnLatencyTrackerComponent::RecordStage(this, this, ESpawnStage::Possessed);
+		}
+		else if (IsLocalController() && LastSpawnRequestTime > 0.f && LastSpawnRequestTime != LastMeasuredSpawnRequestTime && GetWorld()->GetGameState() != nullptr)
+		{
+			LastMeasuredSpawnRequestTime = LastSpawnRequestTime;
+			USpawnLatencyTrackerComponent::RecordClientLatency(this, GetWorld()->GetGameState()->GetServerWorldTimeSeconds() - LastSpawnRequestTime);
+		}
+	}
+
 	if (GetNetMode() == NM_Client && InPawn)
 	{
 		SetViewTarget(InPawn);
@@ -115,9 +143,15 @@ void AGDKPlayerController::SetUIMode(bool bIsUIMode)
 	}
 }
 
-void AGDKPlayerController::ServerTryJoinGame_Implementation()
+void AGDKPlayerController::RecordSpawnRequest()
 {
+	LastSpawnRequestTime = GetWorld()->GetGameState()->GetServerWorldTimeSeconds();
+	USpawnLatencyTrackerComponent::RecordStage(this, this, ESpawnStage::Requested);
+}
 
+void AGDKPlayerController::ServerTryJoinGame_Implementation()
+{
+	RecordSpawnRequest();
 	if (USpawnRequestPublisher* Spawner = Cast<USpawnRequestPublisher>(GetWorld()->GetGameState()->GetComponentByClass(USpawnRequestPublisher::StaticClass())))
 	{
 		Spawner->RequestSpawn(this);
@@ -135,6 +169,11 @@ void AGDKPlayerController::ServerRequestName_Implementation(const FString& NewPl
 	if (PlayerState)
 	{
 		PlayerState->SetPlayerName(NewPlayerName);
+
+		if (UPlayerNameTableComponent* NameTable = UPlayerNameTableComponent::Get(this))
+		{
+			NameTable->RegisterPlayer(PlayerState);
+		}
 	}
 }
 
@@ -158,6 +197,7 @@ bool AGDKPlayerController::ServerRequestMetaData_Validate(const FGDKMetaData New
 
 void AGDKPlayerController::ServerRespawnCharacter_Implementation()
 {
+	RecordSpawnRequest();
 	if (USpawnRequestPublisher* Spawner = Cast<USpawnRequestPublisher>(GetWorld()->GetGameState()->GetComponentByClass(USpawnRequestPublisher::StaticClass())))
 	{
 		Spawner->RequestSpawn(this);
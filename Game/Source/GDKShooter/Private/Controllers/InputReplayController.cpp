@@ -0,0 +1,208 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Controllers/InputReplayController.h"
+#include "Characters/Components/EquippedComponent.h"
+#include "Characters/Components/GDKMovementComponent.h"
+#include "Characters/Components/MetaDataComponent.h"
+#include "Engine/World.h"
+#include "Game/Components/CharacterPoolComponent.h"
+#include "Game/Components/SpawnSelectorComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GDKLogging.h"
+#include "Metrics/GDKFunctionTimings.h"
+
+// What the replay drives, timed inclusively, so the CSV shows what each kind of input costs the server.
+DECLARE_CYCLE_STAT(TEXT("Replay Spawn"), STAT_GDKReplaySpawn, STATGROUP_GDKShooter);
+DECLARE_CYCLE_STAT(TEXT("Replay Movement"), STAT_GDKReplayMovement, STATGROUP_GDKShooter);
+DECLARE_CYCLE_STAT(TEXT("Replay Equip"), STAT_GDKReplayEquip, STATGROUP_GDKShooter);
+DECLARE_CYCLE_STAT(TEXT("Replay Aim"), STAT_GDKReplayAim, STATGROUP_GDKShooter);
+DECLARE_CYCLE_STAT(TEXT("Replay Primary Use"), STAT_GDKReplayPrimaryUse, STATGROUP_GDKShooter);
+
+AInputReplayController::AInputReplayController()
+	: NextFrame(0)
+	, StartTime(0.f)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bWantsPlayerState = true;
+}
+
+void AInputReplayController::StartReplay(TSharedRef<const FInputRecording> InRecording)
+{
+	Recording = InRecording;
+	NextFrame = 0;
+	StartTime = GetWorld()->GetTimeSeconds();
+}
+
+void AInputReplayController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (IsFinished())
+	{
+		return;
+	}
+
+	// Replay on world time, so a run with a fixed time step replays the same frames however long each one takes.
+	const float Elapsed = GetWorld()->GetTimeSeconds() - StartTime;
+	const int32 LastFrame = NextFrame;
+	while (NextFrame < Recording->Frames.Num() && Recording->Frames[NextFrame].Time <= Elapsed)
+	{
+		NextFrame++;
+	}
+
+	// Presses and releases from every frame this tick covers, movement from the latest.
+	for (int32 i = LastFrame; i < NextFrame; i++)
+	{
+		ApplyFrame(Recording->Frames[i], i == NextFrame - 1);
+	}
+}
+
+void AInputReplayController::ApplyFrame(const FRecordedInputFrame& Frame, bool bApplyMovement)
+{
+	if (!Frame.HasFlag(FRecordedInputFrame::HasPawn))
+	{
+		if (Applied.HasFlag(FRecordedInputFrame::HasPawn) && GetPawn() != nullptr)
+		{
+			// The player died and left the pawn behind.
+			APawn* OldPawn = GetPawn();
+			UnPossess();
+			OldPawn->SetLifeSpan(5.f);
+		}
+		Applied = Frame;
+		return;
+	}
+
+	if (!Applied.HasFlag(FRecordedInputFrame::HasPawn) || GetPawn() == nullptr)
+	{
+		SpawnPawn(Frame);
+	}
+
+	ACharacter* Character = Cast<ACharacter>(GetPawn());
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	const uint8 Pressed = Frame.Flags & ~Applied.Flags;
+	const uint8 Released = Applied.Flags & ~Frame.Flags;
+
+	{
+		GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplayMovement);
+
+		if (bApplyMovement)
+		{
+			SetControlRotation(Frame.ControlRotation);
+			Character->AddMovementInput(Frame.MovementInput);
+		}
+
+		if (Pressed & FRecordedInputFrame::Jump)
+		{
+			Character->Jump();
+		}
+		else if (Released & FRecordedInputFrame::Jump)
+		{
+			Character->StopJumping();
+		}
+
+		if (Pressed & FRecordedInputFrame::Crouch)
+		{
+			Character->Crouch();
+		}
+		else if (Released & FRecordedInputFrame::Crouch)
+		{
+			Character->UnCrouch();
+		}
+
+		if (UGDKMovementComponent* Movement = Cast<UGDKMovementComponent>(Character->GetMovementComponent()))
+		{
+			if ((Pressed | Released) & FRecordedInputFrame::Sprint)
+			{
+				Movement->SetWantsToSprint(Frame.HasFlag(FRecordedInputFrame::Sprint));
+			}
+		}
+	}
+
+	if (UEquippedComponent* Equipped = Character->FindComponentByClass<UEquippedComponent>())
+	{
+		if (Frame.HeldIndex != INDEX_NONE && Frame.HeldIndex != Applied.HeldIndex)
+		{
+			GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplayEquip);
+			Equipped->RequestEquip(Frame.HeldIndex);
+		}
+
+		if (Pressed & FRecordedInputFrame::Aim)
+		{
+			GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplayAim);
+			Equipped->StartSecondaryUse();
+		}
+		else if (Released & FRecordedInputFrame::Aim)
+		{
+			GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplayAim);
+			Equipped->StopSecondaryUse();
+		}
+
+		if (Pressed & FRecordedInputFrame::PrimaryUse)
+		{
+			GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplayPrimaryUse);
+			Equipped->StartPrimaryUse();
+		}
+		else if (Released & FRecordedInputFrame::PrimaryUse)
+		{
+			GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplayPrimaryUse);
+			Equipped->StopPrimaryUse();
+		}
+	}
+
+	Applied = Frame;
+}
+
+void AInputReplayController::SpawnPawn(const FRecordedInputFrame& Frame)
+{
+	GDK_SCOPE_CYCLE_COUNTER(STAT_GDKReplaySpawn);
+
+	if (APawn* OldPawn = GetPawn())
+	{
+		UnPossess();
+		OldPawn->SetLifeSpan(5.f);
+	}
+
+	// Through the same start selection and character pool as a player's spawn, so spawning costs what it did live.
+	AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	AActor* StartSpot = nullptr;
+	if (USpawnSelectorComponent* SpawnSelector = USpawnSelectorComponent::Get(this))
+	{
+		StartSpot = SpawnSelector->SelectSpawnPoint(this);
+	}
+	if (StartSpot == nullptr)
+	{
+		StartSpot = GameMode->ChoosePlayerStart(this);
+	}
+
+	APawn* NewPawn = StartSpot != nullptr ? UCharacterPoolComponent::SpawnPawnFor(GameMode, this, StartSpot) : nullptr;
+	if (NewPawn == nullptr)
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Failed to spawn a pawn to replay %s's input"), *Recording->PlayerName);
+		return;
+	}
+
+	// The recorded movement only leads where the player went from where they spawned.
+	NewPawn->TeleportTo(Frame.Location, FRotator(0.f, Frame.ControlRotation.Yaw, 0.f), false, true);
+	Possess(NewPawn);
+
+	if (PlayerState != nullptr)
+	{
+		if (UMetaDataComponent* StateMetaData = PlayerState->FindComponentByClass<UMetaDataComponent>())
+		{
+			if (UMetaDataComponent* MetaData = NewPawn->FindComponentByClass<UMetaDataComponent>())
+			{
+				MetaData->SetMetaData(StateMetaData->GetMetaData());
+			}
+		}
+	}
+
+	// Nothing is held down on a fresh pawn.
+	Applied = FRecordedInputFrame();
+	Applied.Flags = FRecordedInputFrame::HasPawn;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "GDKRandom.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+FRandomStream FGDKRandom::Streams[(int32)EGDKRandomStream::Count];
+bool FGDKRandom::bInitialized = false;
+bool FGDKRandom::bFixedSeed = false;
+
+void FGDKRandom::Initialize()
+{
+	bInitialized = true;
+
+	int32 Seed;
+	if (FParse::Value(FCommandLine::Get(), TEXT("GDKRandomSeed="), Seed))
+	{
+		SetSeed(Seed);
+		return;
+	}
+
+	for (FRandomStream& Stream : Streams)
+	{
+		Stream.GenerateNewSeed();
+	}
+}
+
+FRandomStream& FGDKRandom::GetStream(EGDKRandomStream Stream)
+{
+	if (!bInitialized)
+	{
+		Initialize();
+	}
+
+	return Streams[(int32)Stream];
+}
+
+void FGDKRandom::SetSeed(int32 Seed)
+{
+	bInitialized = true;
+	bFixedSeed = true;
+
+	for (int32 i = 0; i < (int32)EGDKRandomStream::Count; i++)
+	{
+		Streams[i].Initialize(Seed + i);
+	}
+}
+
+bool FGDKRandom::HasFixedSeed()
+{
+	if (!bInitialized)
+	{
+		Initialize();
+	}
+
+	return bFixedSeed;
+}
+
+FVector2D FGDKRandom::RandPointInCircle(EGDKRandomStream Stream, float CircleRadius)
+{
+	FRandomStream& RandomStream = GetStream(Stream);
+
+	FVector2D Point;
+	do
+	{
+		Point = FVector2D(RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-1.f, 1.f));
+	} while (Point.SizeSquared() > 1.f);
+
+	return Point * CircleRadius;
+}
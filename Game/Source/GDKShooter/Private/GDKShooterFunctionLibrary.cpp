@@ -1,6 +1,8 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #include "GDKShooterFunctionLibrary.h"
+#include "Characters/Components/TeamComponent.h"
+#include "Game/Components/PerceptionRegistryComponent.h"
 #include "GameFramework/Pawn.h"
 #include "Perception/AIPerceptionStimuliSourceComponent.h"
 
@@ -24,8 +26,17 @@ void UGDKShooterFunctionLibrary::SetGenericTeamId(AActor* Actor, FGenericTeamId
 		TeamAgentController->SetGenericTeamId(NewTeamId);
 	}
 
-	if (UAIPerceptionStimuliSourceComponent* PerceptionStimuli = Actor->FindComponentByClass<UAIPerceptionStimuliSourceComponent>())
+	if (UPerceptionRegistryComponent* PerceptionRegistry = UPerceptionRegistryComponent::Get(Actor))
 	{
+		// A move between buckets. Actors with a team component already move themselves when their team is set.
+		if (Actor->FindComponentByClass<UTeamComponent>() == nullptr)
+		{
+			PerceptionRegistry->UpdateTeam(Actor, GetGenericTeamId(Actor));
+		}
+	}
+	else if (UAIPerceptionStimuliSourceComponent* PerceptionStimuli = Actor->FindComponentByClass<UAIPerceptionStimuliSourceComponent>())
+	{
+		// Without a registry AI finds hostiles through the engine perception system, which only reads teams on registration.
 		PerceptionStimuli->UnregisterFromPerceptionSystem();
 		PerceptionStimuli->RegisterWithPerceptionSystem();
 	}
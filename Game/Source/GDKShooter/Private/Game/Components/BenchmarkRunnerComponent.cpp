@@ -0,0 +1,466 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/BenchmarkRunnerComponent.h"
+#include "AIController.h"
+#include "Characters/GDKCharacter.h"
+#include "Characters/Components/EquippedComponent.h"
+#include "Characters/Components/HealthComponent.h"
+#include "Engine/World.h"
+#include "Game/Components/DeathmatchScoreComponent.h"
+#include "Game/Components/TeamDeathmatchSpawnerComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GDKLogging.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "TimerManager.h"
+#include "Weapons/InstantWeapon.h"
+
+static FAutoConsoleCommandWithWorldAndArgs RunBenchmarksCommand(
+	TEXT("GDK.RunBenchmarks"),
+	TEXT("Runs the server benchmarks and writes Saved/Profiling/Benchmark-<label>.json. Usage: GDK.RunBenchmarks [label]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UBenchmarkRunnerComponent* Runner = UBenchmarkRunnerComponent::Get(World);
+		if (Runner == nullptr || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogGDK, Warning, TEXT("GDK.RunBenchmarks needs a server with a UBenchmarkRunnerComponent on the GameState"));
+			return;
+		}
+
+		Runner->RunBenchmarks(Args.Num() > 0 ? Args[0] : TEXT("Console"));
+	}));
+
+namespace
+{
+	double GetPercentile(const TArray<double>& SortedValues, double Percentile)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile / 100.0 * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+UBenchmarkRunnerComponent::UBenchmarkRunnerComponent()
+	: Scales({ 10, 100, 1000 })
+	, Rounds(20)
+	, StartDelay(5.f)
+	, SpawnOrigin(0.f, 0.f, 100000.f)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+UBenchmarkRunnerComponent* UBenchmarkRunnerComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<UBenchmarkRunnerComponent>(WorldContextObject);
+}
+
+void UBenchmarkRunnerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() == NM_Client || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("GDKBenchmark="), PendingLabel) || FParse::Param(FCommandLine::Get(), TEXT("GDKBenchmark")))
+	{
+		if (PendingLabel.IsEmpty())
+		{
+			PendingLabel = FDateTime::Now().ToString();
+		}
+		GetWorld()->GetTimerManager().SetTimer(StartTimerHandle, this, &UBenchmarkRunnerComponent::RunAndExit, StartDelay, false);
+	}
+}
+
+void UBenchmarkRunnerComponent::RunAndExit()
+{
+	const bool bWritten = !RunBenchmarks(PendingLabel).IsEmpty();
+
+	// Leave the editor running when benchmarking in PIE.
+	if (!GIsEditor)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bWritten ? 0 : 1);
+	}
+}
+
+FString UBenchmarkRunnerComponent::RunBenchmarks(const FString& Label)
+{
+	if (CharacterClass == nullptr)
+	{
+		const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+		UClass* DefaultPawnClass = GameMode != nullptr ? GameMode->DefaultPawnClass.Get() : nullptr;
+		CharacterClass = DefaultPawnClass != nullptr && DefaultPawnClass->IsChildOf<AGDKCharacter>() ? DefaultPawnClass : AGDKCharacter::StaticClass();
+	}
+
+	UE_LOG(LogGDK, Log, TEXT("Running benchmarks %s with %s, %d rounds each"), *Label, *CharacterClass->GetName(), Rounds);
+
+	TArray<FBenchmarkResult> Results;
+	for (int32 NumActors : Scales)
+	{
+		RunScale(NumActors, Results);
+	}
+
+	for (FBenchmarkResult& Result : Results)
+	{
+		Result.NsPerOp.Sort();
+		UE_LOG(LogGDK, Log, TEXT("Benchmark %-20s x%-5d median %10.1f ns/op, p90 %10.1f ns/op"), *Result.Name, Result.NumActors,
+			GetPercentile(Result.NsPerOp, 50.0), GetPercentile(Result.NsPerOp, 90.0));
+	}
+
+	return WriteResults(Label, Results);
+}
+
+void UBenchmarkRunnerComponent::RunScale(int32 NumActors, TArray<FBenchmarkResult>& OutResults)
+{
+	UWorld* World = GetWorld();
+	FRandomStream Random(NumActors);
+	const TArray<AGDKCharacter*> Characters = SpawnCharacters(NumActors);
+
+	// Looked up once, so the timed loops only measure the calls themselves.
+	TArray<UHealthComponent*> HealthComponents;
+	TArray<UEquippedComponent*> EquippedComponents;
+	for (AGDKCharacter* Character : Characters)
+	{
+		HealthComponents.Add(Character->FindComponentByClass<UHealthComponent>());
+		EquippedComponents.Add(Character->FindComponentByClass<UEquippedComponent>());
+	}
+
+	TSubclassOf<AInstantWeapon> Weapon = WeaponClass;
+	if (Weapon == nullptr && Characters.Num() > 0)
+	{
+		const AHoldable* Held = EquippedComponents[0]->CurrentlyHeldItem();
+		if (Held != nullptr && Held->IsA<AInstantWeapon>())
+		{
+			Weapon = Held->GetClass();
+		}
+	}
+
+	// Hit validation, alternating hits inside and well outside each character's bounds.
+	if (Weapon != nullptr)
+	{
+		AInstantWeapon* Validator = World->SpawnActor<AInstantWeapon>(Weapon, FTransform(SpawnOrigin));
+
+		TArray<FInstantHitInfo> Hits;
+		for (int32 i = 0; i < Characters.Num(); i++)
+		{
+			FInstantHitInfo& Hit = Hits.AddDefaulted_GetRef();
+			Hit.HitActor = Characters[i];
+			Hit.bDidHit = true;
+			Hit.Location = Characters[i]->GetActorLocation() + (i % 2 == 0 ? FVector(0.f, 0.f, 20.f) : FVector(1000.f, 0.f, 0.f));
+		}
+
+		int32 NumValid = 0;
+		Measure(TEXT("ValidateHit"), NumActors, Hits.Num(), [] {}, [&]
+		{
+			for (const FInstantHitInfo& Hit : Hits)
+			{
+				NumValid += Validator->ValidateHit(Hit) ? 1 : 0;
+			}
+		}, OutResults);
+		UE_LOG(LogGDK, Verbose, TEXT("%d hits validated"), NumValid);
+
+		World->DestroyActor(Validator);
+
+		// Server authoritative fire, the path AI controlled characters take: one shot each, tracing along the grid row
+		// into the next character and damaging it. Everyone is back to full health before each round.
+		TArray<AAIController*> Controllers;
+		TArray<AInstantWeapon*> Weapons;
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		for (int32 i = 0; i < Characters.Num(); i++)
+		{
+			AInstantWeapon* Held = Cast<AInstantWeapon>(EquippedComponents[i]->CurrentlyHeldItem());
+			if (Held == nullptr)
+			{
+				continue;
+			}
+
+			AAIController* Controller = World->SpawnActor<AAIController>(AAIController::StaticClass(), SpawnParameters);
+			Controller->Possess(Characters[i]);
+			Controllers.Add(Controller);
+
+			Held->SetIsActive(true);
+			Weapons.Add(Held);
+		}
+
+		Measure(TEXT("AuthoritativeFire"), NumActors, Weapons.Num(), [&]
+		{
+			for (UHealthComponent* Health : HealthComponents)
+			{
+				Health->ResetHealth();
+			}
+		}, [&]
+		{
+			for (AInstantWeapon* Held : Weapons)
+			{
+				Held->DoFire();
+			}
+		}, OutResults);
+
+		for (AAIController* Controller : Controllers)
+		{
+			Controller->UnPossess();
+			World->DestroyActor(Controller);
+		}
+	}
+	else
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Skipping weapon benchmarks, set WeaponClass or give %s an instant weapon to start with"), *CharacterClass->GetName());
+	}
+
+	// Damage without an instigator, reset to full health before each round so nobody dies part way.
+	Measure(TEXT("TakeDamage"), NumActors, HealthComponents.Num(), [&]
+	{
+		for (UHealthComponent* Health : HealthComponents)
+		{
+			Health->ResetHealth();
+		}
+	}, [&]
+	{
+		FPointDamageEvent DamageEvent;
+		for (UHealthComponent* Health : HealthComponents)
+		{
+			Health->TakeDamage(1.f, DamageEvent, nullptr, nullptr);
+		}
+	}, OutResults);
+
+	// Scores for NumActors players, with as many kills per round.
+	TArray<FPlayerScore> Scores;
+	for (int32 i = 0; i < NumActors; i++)
+	{
+		FPlayerScore& Score = Scores.AddDefaulted_GetRef();
+		Score.PlayerId = i;
+		Score.Kills = Random.RandRange(0, 30);
+		Score.Deaths = Random.RandRange(0, 30);
+	}
+
+	UDeathmatchScoreComponent* ScoreComponent = NewObject<UDeathmatchScoreComponent>(GetOwner());
+	ScoreComponent->RestorePlayerScores(Scores);
+
+	TArray<TPair<int32, int32>> Kills;
+	for (int32 i = 0; i < NumActors; i++)
+	{
+		Kills.Emplace(Random.RandRange(0, NumActors - 1), Random.RandRange(0, NumActors - 1));
+	}
+
+	Measure(TEXT("RecordKill"), NumActors, Kills.Num(), [] {}, [&]
+	{
+		for (const TPair<int32, int32>& Kill : Kills)
+		{
+			ScoreComponent->RecordKill(Kill.Key, Kill.Value);
+		}
+	}, OutResults);
+
+	// The sort both score components run in OnRep on clients, from unsorted each round.
+	TArray<FPlayerScore> SortedScores;
+	Measure(TEXT("SortPlayerScores"), NumActors, 1, [&]
+	{
+		SortedScores = Scores;
+	}, [&]
+	{
+		UDeathmatchScoreComponent::SortPlayerScores(SortedScores);
+	}, OutResults);
+
+	ScoreComponent->MarkPendingKill();
+
+	// Team spawns for NumActors new players through the GameState's spawner, forgetting them before each round so every
+	// player is assigned a team again.
+	UTeamDeathmatchSpawnerComponent* Spawner = GetOwner()->FindComponentByClass<UTeamDeathmatchSpawnerComponent>();
+	AGameModeBase* GameMode = World->GetAuthGameMode();
+	if (Spawner != nullptr && GameMode != nullptr)
+	{
+		TArray<APlayerController*> Controllers;
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			Controllers.Add(World->SpawnActor<APlayerController>(GameMode->PlayerControllerClass, SpawnParameters));
+		}
+
+		auto RemovePlayers = [&]
+		{
+			for (APlayerController* Controller : Controllers)
+			{
+				if (APawn* Pawn = Controller->GetPawn())
+				{
+					Controller->UnPossess();
+					World->DestroyActor(Pawn);
+				}
+				Spawner->PlayerDisconnected(Controller);
+			}
+		};
+
+		Measure(TEXT("RequestSpawn"), NumActors, Controllers.Num(), RemovePlayers, [&]
+		{
+			for (APlayerController* Controller : Controllers)
+			{
+				Spawner->RequestSpawn(Controller);
+			}
+		}, OutResults);
+
+		RemovePlayers();
+		for (APlayerController* Controller : Controllers)
+		{
+			World->DestroyActor(Controller);
+		}
+	}
+	else
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Skipping the spawn benchmark, the GameState has no UTeamDeathmatchSpawnerComponent"));
+	}
+
+	// Granting one more holdable to each character, back to the starting loadout before each round.
+	if (Weapon != nullptr)
+	{
+		TArray<AHoldable*> Granted;
+		Measure(TEXT("Grant"), NumActors, Characters.Num(), [&]
+		{
+			Granted.Reset();
+			for (UEquippedComponent* Equipped : EquippedComponents)
+			{
+				Equipped->ResetToStarterTemplates();
+				Granted.Add(World->SpawnActor<AHoldable>(Weapon, Equipped->GetOwner()->GetActorTransform()));
+			}
+		}, [&]
+		{
+			for (int32 i = 0; i < EquippedComponents.Num(); i++)
+			{
+				EquippedComponents[i]->Grant(Granted[i]);
+			}
+		}, OutResults);
+
+		// Switching between the first slot and the granted holdable.
+		int32 EquipRound = 0;
+		Measure(TEXT("Equip"), NumActors, EquippedComponents.Num(), [] {}, [&]
+		{
+			const int32 Slot = EquipRound++ % 2 == 0 ? 0 : 1;
+			for (UEquippedComponent* Equipped : EquippedComponents)
+			{
+				Equipped->RequestEquip(Slot);
+			}
+		}, OutResults);
+	}
+
+	for (AGDKCharacter* Character : Characters)
+	{
+		World->DestroyActor(Character);
+	}
+}
+
+void UBenchmarkRunnerComponent::Measure(const FString& Name, int32 NumActors, int32 OpsPerRound, TFunctionRef<void()> Prepare, TFunctionRef<void()> Round, TArray<FBenchmarkResult>& OutResults)
+{
+	if (OpsPerRound <= 0)
+	{
+		return;
+	}
+
+	FBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+	Result.Name = Name;
+	Result.NumActors = NumActors;
+	Result.OpsPerRound = OpsPerRound;
+
+	for (int32 i = 0; i <= FMath::Max(Rounds, 1); i++)
+	{
+		Prepare();
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Round();
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+
+		// The first round warms caches and lazily created state.
+		if (i > 0)
+		{
+			Result.NsPerOp.Add(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000000.0 / OpsPerRound);
+		}
+	}
+}
+
+TArray<AGDKCharacter*> UBenchmarkRunnerComponent::SpawnCharacters(int32 NumActors)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	FGDKMetaData MetaData;
+	MetaData.Customization = 0;
+
+	TArray<AGDKCharacter*> Characters;
+	const int32 RowLength = FMath::CeilToInt(FMath::Sqrt((float)NumActors));
+	for (int32 i = 0; i < NumActors; i++)
+	{
+		const FVector Location = SpawnOrigin + FVector((i % RowLength) * 200.f, (i / RowLength) * 200.f, 0.f);
+		AGDKCharacter* Character = GetWorld()->SpawnActor<AGDKCharacter>(CharacterClass, FTransform(Location), SpawnParameters);
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		// Same as a pooled character, which has its starting loadout before it is first used.
+		if (UEquippedComponent* Equipped = Character->FindComponentByClass<UEquippedComponent>())
+		{
+			Equipped->SpawnStarterTemplates(MetaData);
+		}
+		Characters.Add(Character);
+	}
+
+	return Characters;
+}
+
+FString UBenchmarkRunnerComponent::WriteResults(const FString& Label, const TArray<FBenchmarkResult>& Results) const
+{
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("label"), Label);
+	Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Writer->WriteValue(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Writer->WriteValue(TEXT("buildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+	Writer->WriteValue(TEXT("map"), GetWorld()->GetMapName());
+	Writer->WriteValue(TEXT("characterClass"), CharacterClass->GetName());
+	Writer->WriteValue(TEXT("rounds"), Rounds);
+
+	Writer->WriteArrayStart(TEXT("results"));
+	for (const FBenchmarkResult& Result : Results)
+	{
+		double Total = 0.0;
+		for (double Value : Result.NsPerOp)
+		{
+			Total += Value;
+		}
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Result.Name);
+		Writer->WriteValue(TEXT("actors"), Result.NumActors);
+		Writer->WriteValue(TEXT("opsPerRound"), Result.OpsPerRound);
+		Writer->WriteValue(TEXT("meanNs"), Total / Result.NsPerOp.Num());
+		Writer->WriteValue(TEXT("minNs"), Result.NsPerOp[0]);
+		Writer->WriteValue(TEXT("medianNs"), GetPercentile(Result.NsPerOp, 50.0));
+		Writer->WriteValue(TEXT("p90Ns"), GetPercentile(Result.NsPerOp, 90.0));
+		Writer->WriteValue(TEXT("maxNs"), Result.NsPerOp.Last());
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	const FString Path = FPaths::Combine(FPaths::ProfilingDir(), FString::Printf(TEXT("Benchmark-%s.json"), *FPaths::MakeValidFileName(Label)));
+	if (!FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Failed to write benchmark results to %s"), *Path);
+		return FString();
+	}
+
+	UE_LOG(LogGDK, Log, TEXT("Benchmark results written to %s"), *Path);
+	return Path;
+}
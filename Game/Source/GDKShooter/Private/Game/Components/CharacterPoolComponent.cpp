@@ -0,0 +1,193 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/CharacterPoolComponent.h"
+#include "Characters/GDKCharacter.h"
+#include "Engine/World.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "EngineUtils.h"
+#include "Game/Components/SpawnLatencyTrackerComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "GDKLogging.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "GDKStats.h"
+#include "LoadBalancing/AbstractLBStrategy.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Pawn"), STAT_GDKSpawnPawn, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pawns Created"), STAT_GDKPawnsCreated, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pawns Reused"), STAT_GDKPawnsReused, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pawns Available"), STAT_GDKPooledPawnsAvailable, STATGROUP_GDKShooter);
+
+UCharacterPoolComponent::UCharacterPoolComponent()
+	: NumWarmedUp(0)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCharacterPoolComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!GetOwner()->HasAuthority() || PooledCharacterClass == nullptr)
+	{
+		return;
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(WarmUpTimerHandle, this, &UCharacterPoolComponent::WarmUp, 0.1f, true);
+}
+
+void UCharacterPoolComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(WarmUpTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UCharacterPoolComponent* UCharacterPoolComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<UCharacterPoolComponent>(WorldContextObject);
+}
+
+bool UCharacterPoolComponent::CanPark() const
+{
+	const USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(GetWorld()->GetNetDriver());
+	return SpatialNetDriver == nullptr || SpatialNetDriver->LoadBalanceStrategy == nullptr || SpatialNetDriver->LoadBalanceStrategy->IsReady();
+}
+
+FVector UCharacterPoolComponent::GetParkingLocation()
+{
+	if (ParkingLocation.IsSet())
+	{
+		return ParkingLocation.GetValue();
+	}
+
+	const USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(GetWorld()->GetNetDriver());
+	if (SpatialNetDriver == nullptr || SpatialNetDriver->LoadBalanceStrategy == nullptr)
+	{
+		// Without Unreal load balancing one worker has everything, so anywhere will do.
+		ParkingLocation = FVector(0.f, 0.f, ParkingHeight);
+		return ParkingLocation.GetValue();
+	}
+
+	if (!SpatialNetDriver->LoadBalanceStrategy->IsReady())
+	{
+		// Not cached, so the next character parked goes to the right place.
+		return FVector(0.f, 0.f, ParkingHeight);
+	}
+
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		if (SpatialNetDriver->LoadBalanceStrategy->ShouldHaveAuthority(**It))
+		{
+			ParkingLocation = FVector(FVector2D(It->GetActorLocation()), ParkingHeight);
+			return ParkingLocation.GetValue();
+		}
+	}
+
+	UE_LOG(LogGDK, Warning, TEXT("No player start on this worker to park pooled characters under, parked characters may be handed over"));
+	ParkingLocation = FVector(0.f, 0.f, ParkingHeight);
+	return ParkingLocation.GetValue();
+}
+
+void UCharacterPoolComponent::WarmUp()
+{
+	// Characters created before then could be parked on another worker's part of the map.
+	if (!CanPark())
+	{
+		return;
+	}
+
+	const FVector WarmUpLocation = GetParkingLocation();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 i = 0; i < WarmUpBatchSize && NumWarmedUp < InitialPoolSize; i++, NumWarmedUp++)
+	{
+		AGDKCharacter* Character = GetWorld()->SpawnActor<AGDKCharacter>(PooledCharacterClass, FTransform(WarmUpLocation), SpawnParameters);
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		// Create the holdables now too, the meta data is passed on to them when the character is first used.
+		FGDKMetaData MetaData;
+		MetaData.Customization = 0;
+		if (UEquippedComponent* EquippedComponent = Character->FindComponentByClass<UEquippedComponent>())
+		{
+			EquippedComponent->SpawnStarterTemplates(MetaData);
+		}
+
+		Character->ParkInPool(WarmUpLocation);
+		AvailableCharacters.Add(Character);
+		INC_DWORD_STAT(STAT_GDKPawnsCreated);
+	}
+
+	SET_DWORD_STAT(STAT_GDKPooledPawnsAvailable, AvailableCharacters.Num());
+
+	if (NumWarmedUp >= InitialPoolSize)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(WarmUpTimerHandle);
+	}
+}
+
+AGDKCharacter* UCharacterPoolComponent::Acquire(const FTransform& SpawnTransform)
+{
+	while (AvailableCharacters.Num() > 0)
+	{
+		AGDKCharacter* Character = AvailableCharacters.Pop(false);
+		SET_DWORD_STAT(STAT_GDKPooledPawnsAvailable, AvailableCharacters.Num());
+
+		if (IsValid(Character))
+		{
+			Character->ResetForRespawn(SpawnTransform);
+			return Character;
+		}
+	}
+	return nullptr;
+}
+
+bool UCharacterPoolComponent::Release(AGDKCharacter* Character)
+{
+	if (Character == nullptr || Character->GetClass() != PooledCharacterClass || AvailableCharacters.Num() >= MaxPoolSize)
+	{
+		return false;
+	}
+
+	Character->ParkInPool(GetParkingLocation());
+	AvailableCharacters.Add(Character);
+	SET_DWORD_STAT(STAT_GDKPooledPawnsAvailable, AvailableCharacters.Num());
+	return true;
+}
+
+APawn* UCharacterPoolComponent::SpawnPawnFor(AGameModeBase* GameMode, AController* Controller, AActor* StartSpot)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKSpawnPawn);
+	const double StartTime = FPlatformTime::Seconds();
+
+	APawn* NewPawn = nullptr;
+
+	UCharacterPoolComponent* CharacterPool = Get(GameMode);
+	if (CharacterPool != nullptr && StartSpot != nullptr && GameMode->GetDefaultPawnClassForController(Controller) == CharacterPool->PooledCharacterClass)
+	{
+		// Same as SpawnDefaultPawnFor, only the yaw of the start spot is used.
+		const FRotator StartRotation(0.f, StartSpot->GetActorRotation().Yaw, 0.f);
+		NewPawn = CharacterPool->Acquire(FTransform(StartRotation, StartSpot->GetActorLocation()));
+	}
+
+	if (NewPawn != nullptr)
+	{
+		INC_DWORD_STAT(STAT_GDKPawnsReused);
+	}
+	else
+	{
+		NewPawn = GameMode->SpawnDefaultPawnFor(Controller, StartSpot);
+		INC_DWORD_STAT(STAT_GDKPawnsCreated);
+	}
+
+	USpawnLatencyTrackerComponent::RecordStage(GameMode, Controller, ESpawnStage::PawnSpawned);
+
+	UE_LOG(LogGDK, Verbose, TEXT("Spawned pawn %s for %s in %.3fms"), *GetNameSafe(NewPawn), *GetNameSafe(Controller), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return NewPawn;
+}
@@ -1,6 +1,7 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #include "Game/Components/DeathmatchScoreComponent.h"
+#include "Game/Components/PlayerNameTableComponent.h"
 #include "Net/UnrealNetwork.h"
 
 UDeathmatchScoreComponent::UDeathmatchScoreComponent()
@@ -9,6 +10,16 @@ UDeathmatchScoreComponent::UDeathmatchScoreComponent()
 	SetIsReplicatedByDefault(true);
 }
 
+void UDeathmatchScoreComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UPlayerNameTableComponent* NameTable = GetOwner()->FindComponentByClass<UPlayerNameTableComponent>())
+	{
+		NameTable->NamesChanged.AddDynamic(this, &UDeathmatchScoreComponent::OnPlayerNamesChanged);
+	}
+}
+
 void UDeathmatchScoreComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -22,13 +33,17 @@ void UDeathmatchScoreComponent::RecordNewPlayer(APlayerState* PlayerState)
 	{
 		FPlayerScore NewPlayerScore;
 		NewPlayerScore.PlayerId = PlayerState->PlayerId;
-		NewPlayerScore.PlayerName = PlayerState->GetPlayerName();
 		NewPlayerScore.Kills = 0;
 		NewPlayerScore.Deaths = 0;
 
 		int32 Index = PlayerScoreArray.Add(NewPlayerScore);
 		PlayerScoreMap.Emplace(NewPlayerScore.PlayerId, Index);
 	}
+
+	if (UPlayerNameTableComponent* NameTable = GetOwner()->FindComponentByClass<UPlayerNameTableComponent>())
+	{
+		NameTable->RegisterPlayer(PlayerState);
+	}
 }
 
 void UDeathmatchScoreComponent::RecordKill(const int32 Killer, const int32 Victim)
@@ -43,17 +58,74 @@ void UDeathmatchScoreComponent::RecordKill(const int32 Killer, const int32 Victi
 	}
 }
 
+void UDeathmatchScoreComponent::ApplyScoreDelta(int32 PlayerId, int32 Kills, int32 Deaths)
+{
+	if (int32* Index = PlayerScoreMap.Find(PlayerId))
+	{
+		PlayerScoreArray[*Index].Kills += Kills;
+		PlayerScoreArray[*Index].Deaths += Deaths;
+	}
+}
+
+void UDeathmatchScoreComponent::RestorePlayerScores(const TArray<FPlayerScore>& Scores)
+{
+	PlayerScoreArray = Scores;
+
+	PlayerScoreMap.Reset();
+	for (int32 i = 0; i < PlayerScoreArray.Num(); i++)
+	{
+		PlayerScoreMap.Emplace(PlayerScoreArray[i].PlayerId, i);
+	}
+}
+
 void UDeathmatchScoreComponent::OnRep_PlayerScores()
 {
 	if (GetNetMode() == NM_Client)
 	{
-		// Re-sort player scores.
-		PlayerScoreArray.Sort([](const FPlayerScore& lhs, const FPlayerScore& rhs)
-		{
-			// Sort in reverse order.
-			return lhs.Kills == rhs.Kills ? lhs.Deaths < rhs.Deaths : lhs.Kills > rhs.Kills;
-		});
+		SortPlayerScores(PlayerScoreArray);
+		ResolvePlayerNames(this, PlayerScoreArray);
 	}
 
 	ScoreEvent.Broadcast(PlayerScoreArray);
 }
+
+void UDeathmatchScoreComponent::OnPlayerNamesChanged()
+{
+	if (GetNetMode() == NM_Client)
+	{
+		ResolvePlayerNames(this, PlayerScoreArray);
+		ScoreEvent.Broadcast(PlayerScoreArray);
+	}
+}
+
+void UDeathmatchScoreComponent::SortPlayerScores(TArray<FPlayerScore>& Scores)
+{
+	Scores.Sort([](const FPlayerScore& lhs, const FPlayerScore& rhs)
+	{
+		// Sort in reverse order.
+		return lhs.Kills == rhs.Kills ? lhs.Deaths < rhs.Deaths : lhs.Kills > rhs.Kills;
+	});
+}
+
+void UDeathmatchScoreComponent::ResolvePlayerNames(const UObject* WorldContextObject, TArray<FPlayerScore>& Scores)
+{
+	const UPlayerNameTableComponent* NameTable = UPlayerNameTableComponent::Get(WorldContextObject);
+
+	for (FPlayerScore& Score : Scores)
+	{
+		const FString* Name = NameTable != nullptr ? NameTable->FindPlayerName(Score.PlayerId) : nullptr;
+		if (Name == nullptr)
+		{
+			// Game states without a name table still have the names on the player states.
+			if (const APlayerState* PlayerState = UPlayerNameTableComponent::FindPlayerState(WorldContextObject, Score.PlayerId))
+			{
+				Score.PlayerName = PlayerState->GetPlayerName();
+			}
+		}
+		// Only assign when the name differs, so re-sorting doesn't reallocate every string.
+		else if (!Score.PlayerName.Equals(*Name, ESearchCase::CaseSensitive))
+		{
+			Score.PlayerName = *Name;
+		}
+	}
+}
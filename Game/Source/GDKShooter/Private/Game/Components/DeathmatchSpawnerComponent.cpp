@@ -5,7 +5,9 @@
 #include "Characters/Components/MetaDataComponent.h"
 #include "Characters/Components/TeamComponent.h"
 #include "Engine/World.h"
+#include "Game/Components/CharacterPoolComponent.h"
 #include "Game/Components/PlayerPublisher.h"
+#include "Game/Components/SpawnSelectorComponent.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "GDKLogging.h"
@@ -32,7 +34,15 @@ void UDeathmatchSpawnerComponent::RequestSpawn(APlayerController* Controller)
 
 AActor* UDeathmatchSpawnerComponent::GetSpawnPoint(APlayerController* Controller)
 {
-	AActor* NewStartSpot = GetWorld()->GetAuthGameMode()->ChoosePlayerStart(Controller);
+	AActor* NewStartSpot = nullptr;
+	if (USpawnSelectorComponent* SpawnSelector = GetOwner()->FindComponentByClass<USpawnSelectorComponent>())
+	{
+		NewStartSpot = SpawnSelector->SelectSpawnPoint(Controller);
+	}
+	if (NewStartSpot == nullptr)
+	{
+		NewStartSpot = GetWorld()->GetAuthGameMode()->ChoosePlayerStart(Controller);
+	}
 	if (NewStartSpot != nullptr)
 	{
 		// Set the player controller / camera in this new location
@@ -69,7 +79,7 @@ void UDeathmatchSpawnerComponent::SpawnCharacter(APlayerController* Controller)
 	{
 		APawn* NewPawn = nullptr;
 
-		NewPawn = GameMode->SpawnDefaultPawnFor(Controller, SpawnPoint);
+		NewPawn = UCharacterPoolComponent::SpawnPawnFor(GameMode, Controller, SpawnPoint);
 
 		Controller->Possess(NewPawn);
 
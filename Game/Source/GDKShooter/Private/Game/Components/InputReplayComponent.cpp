@@ -0,0 +1,149 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/InputReplayComponent.h"
+#include "Controllers/InputReplayController.h"
+#include "Engine/World.h"
+#include "GDKLogging.h"
+#include "GDKRandom.h"
+#include "HAL/FileManager.h"
+#include "Metrics/GDKFunctionTimings.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+
+static const FName FrameTimingName(TEXT("Frame"));
+
+UInputReplayComponent::UInputReplayComponent()
+	: StartDelay(5.f)
+	, FrameTimes(1.0, 1.1, 60)
+	, LastFrameSeconds(0.0)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UInputReplayComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	FString Directory;
+	if (GetNetMode() == NM_Client || !GetOwner()->HasAuthority() || !FParse::Value(FCommandLine::Get(), TEXT("InputReplay="), Directory))
+	{
+		return;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("InputReplayLabel="), Label))
+	{
+		Label = FPaths::GetCleanFilename(Directory);
+	}
+
+	// Sorted, so controllers are spawned in the same order every run.
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(Directory, TEXT("*.input")), true, false);
+	FileNames.Sort();
+
+	for (const FString& FileName : FileNames)
+	{
+		TSharedRef<FInputRecording> Recording = MakeShared<FInputRecording>();
+		if (Recording->LoadFromFile(FPaths::Combine(Directory, FileName)))
+		{
+			Recordings.Add(Recording);
+		}
+		else
+		{
+			UE_LOG(LogGDK, Warning, TEXT("Skipping %s, it isn't an input recording of the current version"), *FileName);
+		}
+	}
+
+	if (Recordings.Num() == 0)
+	{
+		UE_LOG(LogGDK, Error, TEXT("No input recordings found in %s"), *Directory);
+		return;
+	}
+
+	UE_LOG(LogGDK, Log, TEXT("Replaying %d input recordings from %s in %.0fs"), Recordings.Num(), *Directory, StartDelay);
+	GetWorld()->GetTimerManager().SetTimer(StartTimerHandle, this, &UInputReplayComponent::StartReplay, StartDelay, false);
+}
+
+void UInputReplayComponent::StartReplay()
+{
+	int32 Seed = 0;
+	FParse::Value(FCommandLine::Get(), TEXT("GDKRandomSeed="), Seed);
+	FGDKRandom::SetSeed(Seed);
+	// Also covers randomness the game doesn't own, e.g. engine and Blueprint calls.
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (const TSharedRef<const FInputRecording>& Recording : Recordings)
+	{
+		AInputReplayController* Controller = GetWorld()->SpawnActor<AInputReplayController>(SpawnParameters);
+		Controller->StartReplay(Recording);
+		Controllers.Add(Controller);
+	}
+
+	FGDKFunctionTimings::Reset();
+	FGDKFunctionTimings::SetEnabled(true);
+	FrameTimes.Reset();
+	LastFrameSeconds = FPlatformTime::Seconds();
+	SetComponentTickEnabled(true);
+}
+
+void UInputReplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Real time rather than DeltaTime, which is fixed while benchmarking.
+	const double Now = FPlatformTime::Seconds();
+	const double FrameSeconds = Now - LastFrameSeconds;
+	FrameTimes.Add(FrameSeconds * 1000.0);
+	FGDKFunctionTimings::Add(FrameTimingName, (uint64)(FrameSeconds / FPlatformTime::GetSecondsPerCycle64()));
+	LastFrameSeconds = Now;
+
+	for (const AInputReplayController* Controller : Controllers)
+	{
+		if (Controller != nullptr && !Controller->IsFinished())
+		{
+			return;
+		}
+	}
+
+	FinishReplay();
+}
+
+void UInputReplayComponent::FinishReplay()
+{
+	SetComponentTickEnabled(false);
+	FGDKFunctionTimings::SetEnabled(false);
+
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FString::Printf(TEXT("InputReplay-%s.csv"), *Label));
+	if (FFileHelper::SaveStringToFile(FGDKFunctionTimings::ToCsv(), *Path))
+	{
+		UE_LOG(LogGDK, Log, TEXT("Input replay %s finished, frame ms %s, timings written to %s"), *Label, *FrameTimes.ToString(), *Path);
+	}
+	else
+	{
+		UE_LOG(LogGDK, Error, TEXT("Failed to write input replay timings to %s"), *Path);
+	}
+
+	for (AInputReplayController* Controller : Controllers)
+	{
+		if (Controller != nullptr)
+		{
+			if (APawn* Pawn = Controller->GetPawn())
+			{
+				Pawn->Destroy();
+			}
+			Controller->Destroy();
+		}
+	}
+	Controllers.Empty();
+
+	// Leave the editor running when replaying in PIE.
+	if (!GIsEditor)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, 0);
+	}
+}
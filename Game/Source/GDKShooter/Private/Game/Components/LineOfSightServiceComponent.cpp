@@ -0,0 +1,245 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/LineOfSightServiceComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "GDKStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Line Of Sight"), STAT_GDKLineOfSight, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Cache Hits"), STAT_GDKLineOfSightCacheHits, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Sync Traces"), STAT_GDKLineOfSightSyncTraces, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Async Traces"), STAT_GDKLineOfSightAsyncTraces, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Line Of Sight Queued Checks"), STAT_GDKLineOfSightQueuedChecks, STATGROUP_GDKShooter);
+
+ULineOfSightServiceComponent::ULineOfSightServiceComponent()
+	: NextPendingCheckId(0)
+	, BudgetFrame(0)
+	, SyncTracesThisFrame(0)
+	, LastSweepTime(0.f)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	TraceDelegate.BindUObject(this, &ULineOfSightServiceComponent::OnTraceCompleted);
+}
+
+ULineOfSightServiceComponent* ULineOfSightServiceComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<ULineOfSightServiceComponent>(WorldContextObject);
+}
+
+bool ULineOfSightServiceComponent::CanBeSeenFrom(const AActor* Target, const TArray<FVector>& TargetPoints, ECollisionChannel Channel, const FVector& ObserverLocation,
+	FVector& OutSeenLocation, int32& NumberOfLoSChecksPerformed, float& OutSightStrength, const AActor* Observer)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKLineOfSight);
+
+	NumberOfLoSChecksPerformed = 0;
+	OutSightStrength = 0.f;
+
+	if (TargetPoints.Num() == 0)
+	{
+		return false;
+	}
+
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		SyncTracesThisFrame = 0;
+	}
+
+	FLineOfSightResult Result;
+
+	// Without an observer to key on there is nothing to cache against.
+	if (Observer == nullptr)
+	{
+		TraceNow(Target, TargetPoints, Channel, ObserverLocation, Observer, Result, NumberOfLoSChecksPerformed);
+		SyncTracesThisFrame += NumberOfLoSChecksPerformed;
+		OutSeenLocation = Result.SeenLocation;
+		OutSightStrength = Result.SightStrength;
+		return Result.bVisible;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const FLineOfSightKey Key(Observer, Target);
+	FLineOfSightResult* Cached = Cache.Find(Key);
+
+	if (Cached != nullptr && Now - Cached->Time <= CacheLifetime)
+	{
+		INC_DWORD_STAT(STAT_GDKLineOfSightCacheHits);
+	}
+	else if (SyncTracesThisFrame < SyncTraceBudget)
+	{
+		TraceNow(Target, TargetPoints, Channel, ObserverLocation, Observer, Result, NumberOfLoSChecksPerformed);
+		SyncTracesThisFrame += NumberOfLoSChecksPerformed;
+
+		Result.Time = Now;
+		Result.bRefreshQueued = Cached != nullptr && Cached->bRefreshQueued;
+		Cached = &Cache.Add(Key, Result);
+	}
+	else
+	{
+		if (Cached == nullptr)
+		{
+			Cached = &Cache.Add(Key, Result);
+		}
+
+		if (!Cached->bRefreshQueued)
+		{
+			Cached->bRefreshQueued = true;
+			QueueRefresh(Key, TargetPoints, Channel, ObserverLocation);
+		}
+	}
+
+	OutSeenLocation = Cached->SeenLocation;
+	OutSightStrength = Cached->SightStrength;
+	return Cached->bVisible;
+}
+
+bool ULineOfSightServiceComponent::TraceNow(const AActor* Target, const TArray<FVector>& TargetPoints, ECollisionChannel Channel, const FVector& ObserverLocation,
+	const AActor* Observer, FLineOfSightResult& OutResult, int32& OutNumTraces) const
+{
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AILineOfSight), true, Observer);
+
+	int32 NumVisible = 0;
+	OutNumTraces = 0;
+
+	for (const FVector& TargetPoint : TargetPoints)
+	{
+		FHitResult HitResult;
+		const bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, ObserverLocation, TargetPoint, Channel, QueryParams);
+		OutNumTraces++;
+
+		if (bHit == false || (HitResult.Actor.IsValid() && HitResult.Actor->IsOwnedBy(Target)))
+		{
+			if (NumVisible == 0)
+			{
+				OutResult.SeenLocation = TargetPoint;
+			}
+			NumVisible++;
+
+			if (bStopAtFirstVisiblePoint)
+			{
+				break;
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_GDKLineOfSightSyncTraces, OutNumTraces);
+
+	OutResult.bVisible = NumVisible > 0;
+	OutResult.SightStrength = bStopAtFirstVisiblePoint ? (OutResult.bVisible ? 1.f : 0.f) : (float)NumVisible / TargetPoints.Num();
+	return OutResult.bVisible;
+}
+
+void ULineOfSightServiceComponent::QueueRefresh(const FLineOfSightKey& Key, const TArray<FVector>& TargetPoints, ECollisionChannel Channel, const FVector& ObserverLocation)
+{
+	FQueuedCheck& QueuedCheck = QueuedChecks.AddDefaulted_GetRef();
+	QueuedCheck.Key = Key;
+	QueuedCheck.ObserverLocation = ObserverLocation;
+	QueuedCheck.TargetPoints = TargetPoints;
+	QueuedCheck.Channel = Channel;
+
+	SET_DWORD_STAT(STAT_GDKLineOfSightQueuedChecks, QueuedChecks.Num());
+}
+
+void ULineOfSightServiceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	int32 AsyncTracesThisFrame = 0;
+	int32 NumStarted = 0;
+
+	for (; NumStarted < QueuedChecks.Num(); NumStarted++)
+	{
+		const FQueuedCheck& QueuedCheck = QueuedChecks[NumStarted];
+
+		// Always start at least one check per frame, so a small budget can't stall the queue.
+		if (NumStarted > 0 && AsyncTracesThisFrame + QueuedCheck.TargetPoints.Num() > AsyncTraceBudget)
+		{
+			break;
+		}
+
+		if (!QueuedCheck.Key.Key.IsValid() || !QueuedCheck.Key.Value.IsValid())
+		{
+			Cache.Remove(QueuedCheck.Key);
+			continue;
+		}
+
+		const uint32 PendingCheckId = NextPendingCheckId++;
+		FPendingCheck& PendingCheck = PendingChecks.Add(PendingCheckId);
+		PendingCheck.Key = QueuedCheck.Key;
+		PendingCheck.NumPoints = QueuedCheck.TargetPoints.Num();
+		PendingCheck.NumOutstanding = QueuedCheck.TargetPoints.Num();
+
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AILineOfSight), true, QueuedCheck.Key.Key.Get());
+		for (const FVector& TargetPoint : QueuedCheck.TargetPoints)
+		{
+			GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, QueuedCheck.ObserverLocation, TargetPoint, QueuedCheck.Channel,
+				QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, PendingCheckId);
+		}
+
+		AsyncTracesThisFrame += QueuedCheck.TargetPoints.Num();
+	}
+
+	QueuedChecks.RemoveAt(0, NumStarted, false);
+
+	INC_DWORD_STAT_BY(STAT_GDKLineOfSightAsyncTraces, AsyncTracesThisFrame);
+	SET_DWORD_STAT(STAT_GDKLineOfSightQueuedChecks, QueuedChecks.Num());
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (Now - LastSweepTime > 1.f)
+	{
+		SweepCache(Now);
+	}
+}
+
+void ULineOfSightServiceComponent::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FPendingCheck* PendingCheck = PendingChecks.Find(Datum.UserData);
+	if (PendingCheck == nullptr)
+	{
+		return;
+	}
+
+	const AActor* Target = PendingCheck->Key.Value.Get();
+	const FHitResult* BlockingHit = Datum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+	if (BlockingHit == nullptr || (BlockingHit->Actor.IsValid() && BlockingHit->Actor->IsOwnedBy(Target)))
+	{
+		if (PendingCheck->NumVisible == 0)
+		{
+			PendingCheck->SeenLocation = Datum.End;
+		}
+		PendingCheck->NumVisible++;
+	}
+
+	if (--PendingCheck->NumOutstanding > 0)
+	{
+		return;
+	}
+
+	if (Target != nullptr && PendingCheck->Key.Key.IsValid())
+	{
+		FLineOfSightResult& Result = Cache.FindOrAdd(PendingCheck->Key);
+		Result.bVisible = PendingCheck->NumVisible > 0;
+		Result.SeenLocation = PendingCheck->SeenLocation;
+		Result.SightStrength = (float)PendingCheck->NumVisible / PendingCheck->NumPoints;
+		Result.Time = GetWorld()->GetTimeSeconds();
+		Result.bRefreshQueued = false;
+	}
+
+	PendingChecks.Remove(Datum.UserData);
+}
+
+void ULineOfSightServiceComponent::SweepCache(float Now)
+{
+	LastSweepTime = Now;
+
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		const bool bExpired = !It->Value.bRefreshQueued && Now - It->Value.Time > CacheLifetime * 5.f;
+		if (bExpired || !It->Key.Key.IsValid() || !It->Key.Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,497 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/LoadTestScenarioComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetworkObjectList.h"
+#include "Engine/World.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/GDKNetDriver.h"
+#include "GDKLogging.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Net/UnrealNetwork.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	void TryGetFloatField(const TSharedPtr<FJsonObject>& Json, const TCHAR* FieldName, float& OutValue)
+	{
+		double Value;
+		if (Json->TryGetNumberField(FieldName, Value))
+		{
+			OutValue = Value;
+		}
+	}
+
+	void ReadThresholds(const TSharedPtr<FJsonObject>& Json, FLoadTestThresholds& OutThresholds)
+	{
+		if (!Json.IsValid())
+		{
+			return;
+		}
+
+		TryGetFloatField(Json, TEXT("maxFrameTimeP50Ms"), OutThresholds.MaxFrameTimeP50Ms);
+		TryGetFloatField(Json, TEXT("maxFrameTimeP99Ms"), OutThresholds.MaxFrameTimeP99Ms);
+		TryGetFloatField(Json, TEXT("maxOutBytesPerConnectionP90"), OutThresholds.MaxOutBytesPerConnectionP90);
+		TryGetFloatField(Json, TEXT("maxInBytesPerConnectionP90"), OutThresholds.MaxInBytesPerConnectionP90);
+		TryGetFloatField(Json, TEXT("maxRpcsPerSecond"), OutThresholds.MaxRpcsPerSecond);
+		Json->TryGetNumberField(TEXT("maxEntities"), OutThresholds.MaxEntities);
+
+		const TSharedPtr<FJsonObject>* ByFunction;
+		if (Json->TryGetObjectField(TEXT("maxRpcsPerSecondByFunction"), ByFunction))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Limit : (*ByFunction)->Values)
+			{
+				OutThresholds.MaxRpcsPerSecondByFunction.Add(FName(*Limit.Key), Limit.Value->AsNumber());
+			}
+		}
+	}
+
+	// Adds a failure if the limit is set and exceeded.
+	void CheckLimit(const FString& PhaseName, const TCHAR* What, double Value, double Limit, TArray<FString>& OutFailures)
+	{
+		if (Limit > 0.0 && Value > Limit)
+		{
+			OutFailures.Add(FString::Printf(TEXT("%s: %s %.2f exceeds %.2f"), *PhaseName, What, Value, Limit));
+		}
+	}
+}
+
+ULoadTestScenarioComponent::ULoadTestScenarioComponent()
+	: CurrentPhaseIndex(INDEX_NONE)
+	, MeasuredPhaseIndex(INDEX_NONE)
+	, PhaseStartTime(0.0)
+	, LastSampleTime(0.0)
+	, bMeasuring(false)
+	, bFinished(false)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void ULoadTestScenarioComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ULoadTestScenarioComponent, CurrentPhase);
+	DOREPLIFETIME(ULoadTestScenarioComponent, CurrentPhaseIndex);
+}
+
+ULoadTestScenarioComponent* ULoadTestScenarioComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<ULoadTestScenarioComponent>(WorldContextObject);
+}
+
+void ULoadTestScenarioComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	FString Path;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("LoadTestScenario="), Path))
+	{
+		return;
+	}
+
+	if (!LoadScenario(Path))
+	{
+		Exit(false);
+		return;
+	}
+
+	if (UGDKNetDriver* NetDriver = Cast<UGDKNetDriver>(GetWorld()->GetNetDriver()))
+	{
+		NetDriver->SetCountRpcs(true);
+	}
+	else
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Load test %s won't count RPCs, as the net driver isn't a UGDKNetDriver"), *ScenarioName);
+	}
+
+	UE_LOG(LogGDK, Log, TEXT("Load test %s loaded with %d phases, waiting for the first player"), *ScenarioName, Phases.Num());
+	SetComponentTickEnabled(true);
+}
+
+bool ULoadTestScenarioComponent::LoadScenario(const FString& Path)
+{
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Path))
+	{
+		UE_LOG(LogGDK, Error, TEXT("Failed to read load test scenario %s"), *Path);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Json;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Json) || !Json.IsValid())
+	{
+		UE_LOG(LogGDK, Error, TEXT("Load test scenario %s is not valid JSON"), *Path);
+		return false;
+	}
+
+	if (!Json->TryGetStringField(TEXT("name"), ScenarioName))
+	{
+		ScenarioName = FPaths::GetBaseFilename(Path);
+	}
+
+	FLoadTestThresholds DefaultThresholds;
+	const TSharedPtr<FJsonObject>* ThresholdsJson;
+	if (Json->TryGetObjectField(TEXT("thresholds"), ThresholdsJson))
+	{
+		ReadThresholds(*ThresholdsJson, DefaultThresholds);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* PhasesJson;
+	if (!Json->TryGetArrayField(TEXT("phases"), PhasesJson) || PhasesJson->Num() == 0)
+	{
+		UE_LOG(LogGDK, Error, TEXT("Load test scenario %s has no phases"), *Path);
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& PhaseValue : *PhasesJson)
+	{
+		const TSharedPtr<FJsonObject>& PhaseJson = PhaseValue->AsObject();
+		if (!PhaseJson.IsValid())
+		{
+			UE_LOG(LogGDK, Error, TEXT("Load test scenario %s has a phase that isn't an object"), *Path);
+			return false;
+		}
+
+		FLoadTestPhase& Phase = Phases.AddDefaulted_GetRef();
+		Phase.Name = PhaseJson->GetStringField(TEXT("name"));
+		Phase.Duration = PhaseJson->GetNumberField(TEXT("duration"));
+		TryGetFloatField(PhaseJson, TEXT("settleTime"), Phase.SettleTime);
+		TryGetFloatField(PhaseJson, TEXT("disconnectFraction"), Phase.DisconnectFraction);
+
+		if (Phase.Duration <= 0.f)
+		{
+			UE_LOG(LogGDK, Error, TEXT("Load test phase %s needs a positive duration"), *Phase.Name);
+			return false;
+		}
+
+		// Phase thresholds override the scenario's, field by field.
+		Phase.Thresholds = DefaultThresholds;
+		if (PhaseJson->TryGetObjectField(TEXT("thresholds"), ThresholdsJson))
+		{
+			ReadThresholds(*ThresholdsJson, Phase.Thresholds);
+		}
+	}
+
+	PhaseMetrics.SetNum(Phases.Num());
+	return true;
+}
+
+void ULoadTestScenarioComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const double Now = GetWorld()->GetRealTimeSeconds();
+
+	if (GetOwner()->HasAuthority())
+	{
+		AdvanceScenario(Now);
+	}
+
+	if (CurrentPhaseIndex != MeasuredPhaseIndex)
+	{
+		CollectRpcCounts();
+		MeasuredPhaseIndex = CurrentPhaseIndex;
+		PhaseStartTime = Now;
+		bMeasuring = false;
+
+		if (MeasuredPhaseIndex == Phases.Num())
+		{
+			Finish();
+			return;
+		}
+	}
+
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	if (!bMeasuring)
+	{
+		if (Now - PhaseStartTime < Phases[MeasuredPhaseIndex].SettleTime)
+		{
+			return;
+		}
+
+		CollectRpcCounts();
+		bMeasuring = true;
+		LastSampleTime = Now;
+	}
+
+	FPhaseMetrics& Metrics = PhaseMetrics[MeasuredPhaseIndex];
+	Metrics.FrameTime.Add(FMath::Max(FApp::GetDeltaTime() - FApp::GetIdleTime(), 0.0) * 1000.0);
+	Metrics.MeasuredTime += DeltaTime;
+
+	if (Now - LastSampleTime >= 1.0)
+	{
+		LastSampleTime = Now;
+		SampleMetrics();
+	}
+}
+
+void ULoadTestScenarioComponent::AdvanceScenario(double Now)
+{
+	if (CurrentPhaseIndex == INDEX_NONE)
+	{
+		if (GetWorld()->GetGameState()->PlayerArray.Num() > 0)
+		{
+			SetPhase(0);
+		}
+		return;
+	}
+
+	if (IsRunning() && Now - PhaseStartTime >= Phases[CurrentPhaseIndex].Duration)
+	{
+		SetPhase(CurrentPhaseIndex + 1);
+	}
+}
+
+void ULoadTestScenarioComponent::SetPhase(int32 PhaseIndex)
+{
+	CurrentPhaseIndex = PhaseIndex;
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	CurrentPhase = Phases[PhaseIndex];
+	UE_LOG(LogGDK, Log, TEXT("Load test %s starting phase %s for %.0fs"), *ScenarioName, *CurrentPhase.Name, CurrentPhase.Duration);
+	PhaseChanged.Broadcast(CurrentPhase);
+}
+
+void ULoadTestScenarioComponent::CollectRpcCounts()
+{
+	UGDKNetDriver* NetDriver = Cast<UGDKNetDriver>(GetWorld()->GetNetDriver());
+	if (NetDriver == nullptr)
+	{
+		return;
+	}
+
+	if (bMeasuring && PhaseMetrics.IsValidIndex(MeasuredPhaseIndex))
+	{
+		NetDriver->ConsumeRpcCounts(PhaseMetrics[MeasuredPhaseIndex].RpcCounts);
+	}
+	else
+	{
+		TMap<FName, int32> Unmeasured;
+		NetDriver->ConsumeRpcCounts(Unmeasured);
+	}
+}
+
+void ULoadTestScenarioComponent::SampleMetrics()
+{
+	FPhaseMetrics& Metrics = PhaseMetrics[MeasuredPhaseIndex];
+
+	CollectRpcCounts();
+
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr)
+	{
+		return;
+	}
+
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		Metrics.OutBytesPerConnection.Add(Connection->OutBytesPerSecond);
+		Metrics.InBytesPerConnection.Add(Connection->InBytesPerSecond);
+	}
+	Metrics.MaxConnections = FMath::Max(Metrics.MaxConnections, NetDriver->ClientConnections.Num());
+
+	int32 NumAuthoritative = 0;
+	const FNetworkObjectList::FNetworkObjectSet& Objects = NetDriver->GetNetworkObjectList().GetAllObjects();
+	for (const TSharedPtr<FNetworkObjectInfo>& Object : Objects)
+	{
+		if (Object->Actor != nullptr && Object->Actor->HasAuthority())
+		{
+			NumAuthoritative++;
+		}
+	}
+	Metrics.MaxEntities = FMath::Max(Metrics.MaxEntities, Objects.Num());
+	Metrics.MaxAuthoritativeEntities = FMath::Max(Metrics.MaxAuthoritativeEntities, NumAuthoritative);
+}
+
+bool ULoadTestScenarioComponent::CheckThresholds(int32 PhaseIndex, TArray<FString>& OutFailures) const
+{
+	const FLoadTestPhase& Phase = Phases[PhaseIndex];
+	const FLoadTestThresholds& Thresholds = Phase.Thresholds;
+	const FPhaseMetrics& Metrics = PhaseMetrics[PhaseIndex];
+	const int32 NumFailures = OutFailures.Num();
+
+	if (Metrics.FrameTime.GetCount() == 0)
+	{
+		OutFailures.Add(FString::Printf(TEXT("%s: nothing was measured"), *Phase.Name));
+		return false;
+	}
+
+	CheckLimit(Phase.Name, TEXT("frame time p50 ms"), Metrics.FrameTime.GetPercentile(50.0), Thresholds.MaxFrameTimeP50Ms, OutFailures);
+	CheckLimit(Phase.Name, TEXT("frame time p99 ms"), Metrics.FrameTime.GetPercentile(99.0), Thresholds.MaxFrameTimeP99Ms, OutFailures);
+	CheckLimit(Phase.Name, TEXT("out bytes per connection p90"), Metrics.OutBytesPerConnection.GetPercentile(90.0), Thresholds.MaxOutBytesPerConnectionP90, OutFailures);
+	CheckLimit(Phase.Name, TEXT("in bytes per connection p90"), Metrics.InBytesPerConnection.GetPercentile(90.0), Thresholds.MaxInBytesPerConnectionP90, OutFailures);
+	CheckLimit(Phase.Name, TEXT("entities"), Metrics.MaxEntities, Thresholds.MaxEntities, OutFailures);
+
+	int32 TotalRpcs = 0;
+	for (const TPair<FName, int32>& RpcCount : Metrics.RpcCounts)
+	{
+		TotalRpcs += RpcCount.Value;
+	}
+	CheckLimit(Phase.Name, TEXT("RPCs per second"), TotalRpcs / Metrics.MeasuredTime, Thresholds.MaxRpcsPerSecond, OutFailures);
+
+	for (const TPair<FName, float>& Limit : Thresholds.MaxRpcsPerSecondByFunction)
+	{
+		const int32* Count = Metrics.RpcCounts.Find(Limit.Key);
+		const FString What = FString::Printf(TEXT("%s RPCs per second"), *Limit.Key.ToString());
+		CheckLimit(Phase.Name, *What, (Count ? *Count : 0) / Metrics.MeasuredTime, Limit.Value, OutFailures);
+	}
+
+	return OutFailures.Num() == NumFailures;
+}
+
+void ULoadTestScenarioComponent::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+	SetComponentTickEnabled(false);
+
+	bool bPassed = true;
+	TArray<FString> Failures;
+	for (int32 i = 0; i < Phases.Num(); i++)
+	{
+		bPassed &= CheckThresholds(i, Failures);
+	}
+
+	for (const FString& Failure : Failures)
+	{
+		UE_LOG(LogGDK, Error, TEXT("Load test %s failed threshold: %s"), *ScenarioName, *Failure);
+	}
+	UE_LOG(LogGDK, Log, TEXT("Load test %s %s, report written to %s"), *ScenarioName, bPassed ? TEXT("passed") : TEXT("failed"), *WriteReport(bPassed, Failures));
+
+	if (GetOwner()->HasAuthority() && ExitDelay > 0.f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(ExitTimerHandle, FTimerDelegate::CreateUObject(this, &ULoadTestScenarioComponent::Exit, bPassed), ExitDelay, false);
+	}
+	else
+	{
+		Exit(bPassed);
+	}
+}
+
+void ULoadTestScenarioComponent::Exit(bool bPassed)
+{
+	// Leave the editor running when testing a scenario in PIE.
+	if (!GIsEditor)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+FString ULoadTestScenarioComponent::WriteReport(bool bPassed, const TArray<FString>& Failures) const
+{
+	FString WorkerId = TEXT("local");
+	if (const USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(GetNetDriver()))
+	{
+		if (SpatialNetDriver->Connection != nullptr)
+		{
+			WorkerId = SpatialNetDriver->Connection->GetWorkerId();
+		}
+	}
+
+	FString Report;
+	TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Report);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("scenario"), ScenarioName);
+	Writer->WriteValue(TEXT("worker"), WorkerId);
+	Writer->WriteValue(TEXT("passed"), bPassed);
+	Writer->WriteArrayStart(TEXT("failures"));
+	for (const FString& Failure : Failures)
+	{
+		Writer->WriteValue(Failure);
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteArrayStart(TEXT("phases"));
+	for (int32 i = 0; i < Phases.Num(); i++)
+	{
+		const FPhaseMetrics& Metrics = PhaseMetrics[i];
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Phases[i].Name);
+		Writer->WriteValue(TEXT("measuredSeconds"), Metrics.MeasuredTime);
+		Writer->WriteValue(TEXT("frameTimeMs"), Metrics.FrameTime.ToString());
+		Writer->WriteValue(TEXT("frameTimeP50Ms"), Metrics.FrameTime.GetPercentile(50.0));
+		Writer->WriteValue(TEXT("frameTimeP99Ms"), Metrics.FrameTime.GetPercentile(99.0));
+		Writer->WriteValue(TEXT("outBytesPerConnection"), Metrics.OutBytesPerConnection.ToString());
+		Writer->WriteValue(TEXT("inBytesPerConnection"), Metrics.InBytesPerConnection.ToString());
+		Writer->WriteValue(TEXT("maxConnections"), Metrics.MaxConnections);
+		Writer->WriteValue(TEXT("maxEntities"), Metrics.MaxEntities);
+		Writer->WriteValue(TEXT("maxAuthoritativeEntities"), Metrics.MaxAuthoritativeEntities);
+
+		Writer->WriteObjectStart(TEXT("rpcCounts"));
+		for (const TPair<FName, int32>& RpcCount : Metrics.RpcCounts)
+		{
+			Writer->WriteValue(RpcCount.Key.ToString(), RpcCount.Value);
+		}
+		Writer->WriteObjectEnd();
+
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	const FString Path = FPaths::Combine(FPaths::ProfilingDir(), FString::Printf(TEXT("LoadTest-%s-%s.json"), *ScenarioName, *WorkerId));
+	if (!FFileHelper::SaveStringToFile(Report, *Path))
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Failed to write load test report to %s"), *Path);
+		return FString();
+	}
+
+	return Path;
+}
+
+void ULoadTestScenarioComponent::OnRep_CurrentPhase()
+{
+	PhaseChanged.Broadcast(CurrentPhase);
+
+	if (GetNetMode() == NM_Client)
+	{
+		ApplyPhaseToSimulatedPlayer();
+	}
+}
+
+void ULoadTestScenarioComponent::ApplyPhaseToSimulatedPlayer()
+{
+	if (!FParse::Param(FCommandLine::Get(), TEXT("simulatedPlayer")))
+	{
+		return;
+	}
+
+	if (FMath::FRand() < CurrentPhase.DisconnectFraction)
+	{
+		UE_LOG(LogGDK, Log, TEXT("Simulated player disconnecting for load test phase %s"), *CurrentPhase.Name);
+		FPlatformMisc::RequestExit(false);
+	}
+}
@@ -19,16 +19,16 @@ void ULobbyTimerComponent::BeginPlay()
 
 void ULobbyTimerComponent::ServerInformOfPlayerCount_Implementation(int32 PlayerCount)
 {
-	if (bHasTimerFinished || !GetOwner()->HasAuthority())
+	if (HasTimerFinished() || !GetOwner()->HasAuthority())
 	{
 		return;
 	}
 
-	if (!bIsTimerRunning && PlayerCount >= MinimumPlayersToStartCountdown)
+	if (!IsTimerRunning() && PlayerCount >= MinimumPlayersToStartCountdown)
 	{
 		StartTimer();
 	}
-	else if (bIsTimerRunning && PlayerCount < MinimumPlayersToStartCountdown)
+	else if (IsTimerRunning() && PlayerCount < MinimumPlayersToStartCountdown)
 	{
 		StopTimer();
 		SetTimer(DefaultTimerDuration);
@@ -0,0 +1,420 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/MatchCheckpointComponent.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "Game/Components/TeamDeathmatchSpawnerComponent.h"
+#include "Game/Components/TimerComponent.h"
+#include "GDKLogging.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// "GDCK", followed by a version which must be bumped whenever the layout below changes.
+static const uint32 CheckpointMagic = 0x4B434447;
+static const uint32 CheckpointVersion = 1;
+
+// No match comes close to this many players, teams or timers, so a larger count means the file is corrupt.
+static const int32 MaxCheckpointArrayNum = 65536;
+
+// Reads or writes an element count. When loading, also rejects counts that the rest of the archive can't hold,
+// given the fewest bytes each element takes, before anything is allocated for them.
+static bool SerializeArrayNum(FArchive& Ar, int32& Num, int32 MinElementSize)
+{
+	Ar << Num;
+	if (Num < 0 || Num > MaxCheckpointArrayNum || Ar.IsError())
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	if (Ar.IsLoading() && Ar.TotalSize() >= 0 && (int64)Num * MinElementSize > Ar.TotalSize() - Ar.Tell())
+	{
+		Ar.SetError();
+		return false;
+	}
+	return true;
+}
+
+static void SerializePlayerScores(FArchive& Ar, TArray<FPlayerScore>& Scores)
+{
+	// PlayerId, Kills and Deaths.
+	int32 Num = Scores.Num();
+	if (!SerializeArrayNum(Ar, Num, 3 * sizeof(int32)))
+	{
+		return;
+	}
+	if (Ar.IsLoading())
+	{
+		Scores.SetNum(Num);
+	}
+
+	// PlayerName is not stored, it is resolved from the name table.
+	for (FPlayerScore& Score : Scores)
+	{
+		Ar << Score.PlayerId << Score.Kills << Score.Deaths;
+	}
+}
+
+bool FMatchCheckpoint::Serialize(FArchive& Ar)
+{
+	uint32 Magic = CheckpointMagic;
+	uint32 Version = CheckpointVersion;
+	Ar << Magic << Version;
+	if (Magic != CheckpointMagic || Version != CheckpointVersion)
+	{
+		return false;
+	}
+
+	Ar << WrittenAtUtcTicks;
+
+	uint8 MatchStateByte = static_cast<uint8>(MatchState);
+	Ar << bHasMatchState << MatchStateByte;
+	if (MatchStateByte > static_cast<uint8>(EMatchState::PostGame))
+	{
+		Ar.SetError();
+		return false;
+	}
+	MatchState = static_cast<EMatchState>(MatchStateByte);
+
+	// PlayerId and the name's length.
+	int32 NumNames = PlayerNames.Num();
+	if (!SerializeArrayNum(Ar, NumNames, 2 * sizeof(int32)))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		PlayerNames.SetNum(NumNames);
+	}
+	for (FPlayerNameEntry& Entry : PlayerNames)
+	{
+		Ar << Entry.PlayerId << Entry.PlayerName;
+	}
+
+	SerializePlayerScores(Ar, PlayerScores);
+
+	// TeamId, the name's length, TeamScore and the number of player scores.
+	int32 NumTeams = TeamScores.Num();
+	if (!SerializeArrayNum(Ar, NumTeams, sizeof(uint8) + 3 * sizeof(int32)))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		TeamScores.SetNum(NumTeams);
+	}
+	for (FTeamScore& Team : TeamScores)
+	{
+		uint8 TeamId = Team.TeamId.GetId();
+		FString TeamName = Team.TeamName.ToString();
+		Ar << TeamId << TeamName << Team.TeamScore;
+		SerializePlayerScores(Ar, Team.PlayerScores);
+
+		if (Ar.IsLoading())
+		{
+			Team.TeamId = FGenericTeamId(TeamId);
+			Team.TeamName = FName(*TeamName);
+		}
+	}
+
+	// The name's length, TimeLeft and Flags.
+	int32 NumTimers = Timers.Num();
+	if (!SerializeArrayNum(Ar, NumTimers, sizeof(int32) + sizeof(float) + sizeof(uint8)))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		Timers.SetNum(NumTimers);
+	}
+	for (FTimerCheckpoint& Timer : Timers)
+	{
+		FString ComponentName = Timer.ComponentName.ToString();
+		uint8 Flags = (Timer.bIsRunning ? 1 : 0) | (Timer.bHasFinished ? 2 : 0);
+		Ar << ComponentName << Timer.TimeLeft << Flags;
+
+		if (Ar.IsLoading())
+		{
+			Timer.ComponentName = FName(*ComponentName);
+			Timer.bIsRunning = (Flags & 1) != 0;
+			Timer.bHasFinished = (Flags & 2) != 0;
+		}
+	}
+
+	// Same layout as serializing the TMap directly, which would allocate for any count it reads.
+	int32 NumPlayerTeams = PlayerTeams.Num();
+	if (!SerializeArrayNum(Ar, NumPlayerTeams, 2 * sizeof(int32)))
+	{
+		return false;
+	}
+	if (Ar.IsLoading())
+	{
+		PlayerTeams.Empty(NumPlayerTeams);
+		for (int32 i = 0; i < NumPlayerTeams && !Ar.IsError(); i++)
+		{
+			int32 PlayerId = 0;
+			int32 TeamId = 0;
+			Ar << PlayerId << TeamId;
+			PlayerTeams.Add(PlayerId, TeamId);
+		}
+	}
+	else
+	{
+		for (TPair<int32, int32>& PlayerTeam : PlayerTeams)
+		{
+			Ar << PlayerTeam.Key << PlayerTeam.Value;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+UMatchCheckpointComponent::UMatchCheckpointComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMatchCheckpointComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	// Without a session id a checkpoint could be picked up by another deployment's match on this machine.
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MatchSessionId="), SessionId) || SessionId.IsEmpty())
+	{
+		UE_LOG(LogGDK, Log, TEXT("Match checkpoints are off, start the server with -MatchSessionId=<id> to enable them"));
+		return;
+	}
+
+	if (UMatchStateComponent* MatchState = GetOwner()->FindComponentByClass<UMatchStateComponent>())
+	{
+		MatchState->MatchEvent.AddDynamic(this, &UMatchCheckpointComponent::OnMatchStateChanged);
+	}
+
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UMatchCheckpointComponent::StartCheckpointing);
+}
+
+void UMatchCheckpointComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(CheckpointTimerHandle);
+
+	// Don't let the world go away with a write still in flight.
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UMatchCheckpointComponent::StartCheckpointing()
+{
+	if (bRestoreOnStartup)
+	{
+		RestoreCheckpoint();
+	}
+
+	if (CheckpointInterval > 0.f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(CheckpointTimerHandle, this, &UMatchCheckpointComponent::WriteCheckpoint, CheckpointInterval, true);
+	}
+}
+
+void UMatchCheckpointComponent::OnMatchStateChanged(EMatchState NewState)
+{
+	if (NewState == EMatchState::PostGame)
+	{
+		// Nothing left worth recovering.
+		GetWorld()->GetTimerManager().ClearTimer(CheckpointTimerHandle);
+		ClearCheckpoint();
+	}
+}
+
+void UMatchCheckpointComponent::WriteCheckpoint()
+{
+	if (!GetOwner()->HasAuthority() || SessionId.IsEmpty())
+	{
+		return;
+	}
+
+	if (PendingWrite.IsValid() && !PendingWrite.IsReady())
+	{
+		// The previous write is still going, skip this one rather than queue up stale state.
+		return;
+	}
+
+	// Capturing is a handful of array copies, serializing and file IO happen on the thread pool.
+	FMatchCheckpoint Checkpoint;
+	CaptureCheckpoint(Checkpoint);
+
+	PendingWrite = Async(EAsyncExecution::ThreadPool, [Checkpoint = MoveTemp(Checkpoint), Path = GetCheckpointPath()]() mutable
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Checkpoint.Serialize(Writer);
+
+		// Write next to the checkpoint and move it into place, so a crash mid-write can't leave a truncated file behind.
+		const FString TempPath = Path + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+		{
+			UE_LOG(LogGDK, Warning, TEXT("Failed to write match checkpoint to %s"), *Path);
+		}
+	});
+}
+
+bool UMatchCheckpointComponent::RestoreCheckpoint()
+{
+	if (!GetOwner()->HasAuthority() || SessionId.IsEmpty())
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FString Path = GetCheckpointPath();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMatchCheckpoint Checkpoint;
+	FMemoryReader Reader(Bytes);
+	if (!Checkpoint.Serialize(Reader))
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Ignoring match checkpoint %s, it is corrupt or from a different version"), *Path);
+		return false;
+	}
+
+	const double AgeSeconds = (FDateTime::UtcNow() - FDateTime(Checkpoint.WrittenAtUtcTicks)).GetTotalSeconds();
+	if (AgeSeconds > MaxCheckpointAge)
+	{
+		UE_LOG(LogGDK, Log, TEXT("Ignoring match checkpoint %s, it is %.0f seconds old"), *Path, AgeSeconds);
+		return false;
+	}
+
+	ApplyCheckpoint(Checkpoint);
+
+	UE_LOG(LogGDK, Log, TEXT("Restored match checkpoint %s (%.1f seconds old) in %.2fms"), *Path, AgeSeconds, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+void UMatchCheckpointComponent::ClearCheckpoint()
+{
+	if (SessionId.IsEmpty())
+	{
+		return;
+	}
+
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+	}
+
+	IFileManager::Get().Delete(*GetCheckpointPath(), false, false, true);
+}
+
+void UMatchCheckpointComponent::CaptureCheckpoint(FMatchCheckpoint& OutCheckpoint) const
+{
+	AActor* Owner = GetOwner();
+
+	OutCheckpoint.WrittenAtUtcTicks = FDateTime::UtcNow().GetTicks();
+
+	if (UMatchStateComponent* MatchState = Owner->FindComponentByClass<UMatchStateComponent>())
+	{
+		OutCheckpoint.bHasMatchState = true;
+		OutCheckpoint.MatchState = MatchState->GetCurrentState();
+	}
+
+	if (UPlayerNameTableComponent* NameTable = Owner->FindComponentByClass<UPlayerNameTableComponent>())
+	{
+		OutCheckpoint.PlayerNames = NameTable->GetEntries();
+	}
+
+	if (UDeathmatchScoreComponent* DeathmatchScore = Owner->FindComponentByClass<UDeathmatchScoreComponent>())
+	{
+		OutCheckpoint.PlayerScores = DeathmatchScore->PlayerScores();
+	}
+
+	if (UTeamDeathmatchScoreComponent* TeamDeathmatchScore = Owner->FindComponentByClass<UTeamDeathmatchScoreComponent>())
+	{
+		OutCheckpoint.TeamScores = TeamDeathmatchScore->TeamScores();
+	}
+
+	TInlineComponentArray<UTimerComponent*> TimerComponents(Owner);
+	for (UTimerComponent* TimerComponent : TimerComponents)
+	{
+		FTimerCheckpoint& Timer = OutCheckpoint.Timers.AddDefaulted_GetRef();
+		Timer.ComponentName = TimerComponent->GetFName();
+		Timer.TimeLeft = TimerComponent->GetTimer();
+		Timer.bIsRunning = TimerComponent->IsTimerRunning();
+		Timer.bHasFinished = TimerComponent->HasTimerFinished();
+	}
+
+	if (UTeamDeathmatchSpawnerComponent* Spawner = Owner->FindComponentByClass<UTeamDeathmatchSpawnerComponent>())
+	{
+		Spawner->GetPlayerTeams(OutCheckpoint.PlayerTeams);
+	}
+}
+
+void UMatchCheckpointComponent::ApplyCheckpoint(const FMatchCheckpoint& Checkpoint)
+{
+	AActor* Owner = GetOwner();
+
+	if (UPlayerNameTableComponent* NameTable = Owner->FindComponentByClass<UPlayerNameTableComponent>())
+	{
+		NameTable->RestoreEntries(Checkpoint.PlayerNames);
+	}
+
+	if (UDeathmatchScoreComponent* DeathmatchScore = Owner->FindComponentByClass<UDeathmatchScoreComponent>())
+	{
+		DeathmatchScore->RestorePlayerScores(Checkpoint.PlayerScores);
+	}
+
+	if (UTeamDeathmatchScoreComponent* TeamDeathmatchScore = Owner->FindComponentByClass<UTeamDeathmatchScoreComponent>())
+	{
+		TeamDeathmatchScore->RestoreTeamScores(Checkpoint.TeamScores);
+	}
+
+	TInlineComponentArray<UTimerComponent*> TimerComponents(Owner);
+	for (const FTimerCheckpoint& Timer : Checkpoint.Timers)
+	{
+		for (UTimerComponent* TimerComponent : TimerComponents)
+		{
+			if (TimerComponent->GetFName() == Timer.ComponentName)
+			{
+				TimerComponent->RestoreTimer(Timer.TimeLeft, Timer.bIsRunning, Timer.bHasFinished);
+				break;
+			}
+		}
+	}
+
+	if (UTeamDeathmatchSpawnerComponent* Spawner = Owner->FindComponentByClass<UTeamDeathmatchSpawnerComponent>())
+	{
+		Spawner->RestorePlayerTeams(Checkpoint.PlayerTeams);
+	}
+
+	// Match state goes last, so anything listening for it sees the restored scores and timers.
+	if (Checkpoint.bHasMatchState)
+	{
+		if (UMatchStateComponent* MatchState = Owner->FindComponentByClass<UMatchStateComponent>())
+		{
+			MatchState->SetMatchState(Checkpoint.MatchState);
+		}
+	}
+}
+
+FString UMatchCheckpointComponent::GetCheckpointPath() const
+{
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	const FString FileName = FPaths::MakeValidFileName(FString::Printf(TEXT("%s-%s.ckpt"), *SessionId, *MapName));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Checkpoints"), FileName);
+}
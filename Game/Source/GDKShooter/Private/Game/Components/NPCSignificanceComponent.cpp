@@ -0,0 +1,239 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/NPCSignificanceComponent.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Characters/GDKCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "GDKStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Sight.h"
+
+DECLARE_CYCLE_STAT(TEXT("NPC Significance"), STAT_GDKNPCSignificance, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs High Significance"), STAT_GDKNPCsHigh, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs Medium Significance"), STAT_GDKNPCsMedium, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NPCs Low Significance"), STAT_GDKNPCsLow, STATGROUP_GDKShooter);
+
+static TAutoConsoleVariable<int32> CVarNPCSignificanceEnabled(
+	TEXT("GDK.NPCSignificance.Enabled"),
+	1,
+	TEXT("When 0, every NPC ticks at full rate."));
+
+UNPCSignificanceComponent::UNPCSignificanceComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	HighSignificance.MaxDistance = 5000.f;
+
+	MediumSignificance.MaxDistance = 15000.f;
+	MediumSignificance.TickInterval = 0.1f;
+	MediumSignificance.BehaviorTreeTickInterval = 0.25f;
+
+	LowSignificance.TickInterval = 0.5f;
+	LowSignificance.BehaviorTreeTickInterval = 1.f;
+}
+
+void UNPCSignificanceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Every server worker evaluates the NPCs it is authoritative over.
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(EvaluationTimerHandle, this, &UNPCSignificanceComponent::Evaluate, EvaluationInterval, true);
+}
+
+void UNPCSignificanceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(EvaluationTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UNPCSignificanceComponent* UNPCSignificanceComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<UNPCSignificanceComponent>(WorldContextObject);
+}
+
+void UNPCSignificanceComponent::RegisterCharacter(AGDKCharacter* Character)
+{
+	if (Character != nullptr)
+	{
+		Characters.FindOrAdd(Character);
+	}
+}
+
+void UNPCSignificanceComponent::UnregisterCharacter(AGDKCharacter* Character)
+{
+	Characters.Remove(Character);
+}
+
+void UNPCSignificanceComponent::AddInterestSource(AActor* Source)
+{
+	if (Source != nullptr)
+	{
+		InterestSources.AddUnique(Source);
+	}
+}
+
+void UNPCSignificanceComponent::RemoveInterestSource(AActor* Source)
+{
+	InterestSources.Remove(Source);
+}
+
+void UNPCSignificanceComponent::NotifyDamaged(AGDKCharacter* Character)
+{
+	FNPCSignificanceState* State = Characters.Find(Character);
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	State->PromotedUntil = GetWorld()->GetTimeSeconds() + DamagePromotionTime;
+
+	if (State->Significance != ENPCSignificance::High)
+	{
+		State->Significance = ENPCSignificance::High;
+		ApplySignificance(Character, ENPCSignificance::High);
+	}
+}
+
+void UNPCSignificanceComponent::Evaluate()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKNPCSignificance);
+
+	const bool bEnabled = CVarNPCSignificanceEnabled.GetValueOnGameThread() != 0;
+
+	// Player characters are the ones with a player state, wherever they are controlled from and whichever worker
+	// is authoritative over them.
+	TArray<FVector> InterestLocations;
+	for (const TPair<TWeakObjectPtr<AGDKCharacter>, FNPCSignificanceState>& Pair : Characters)
+	{
+		const AGDKCharacter* Character = Pair.Key.Get();
+		if (Character != nullptr && Character->GetPlayerState() != nullptr && !Character->IsHidden())
+		{
+			InterestLocations.Add(Character->GetActorLocation());
+		}
+	}
+
+	for (int i = InterestSources.Num() - 1; i >= 0; i--)
+	{
+		if (const AActor* Source = InterestSources[i].Get())
+		{
+			InterestLocations.Add(Source->GetActorLocation());
+		}
+		else
+		{
+			InterestSources.RemoveAtSwap(i);
+		}
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	int32 TierCounts[3] = { 0, 0, 0 };
+
+	for (auto It = Characters.CreateIterator(); It; ++It)
+	{
+		AGDKCharacter* Character = It->Key.Get();
+		if (Character == nullptr)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		FNPCSignificanceState& State = It->Value;
+
+		// Characters this worker isn't authoritative over go back to full rate, so they are not left throttled
+		// if it gains authority over them again.
+		ENPCSignificance NewSignificance = ENPCSignificance::High;
+		if (bEnabled && IsThrottleable(Character) && Now >= State.PromotedUntil)
+		{
+			NewSignificance = Classify(Character->GetActorLocation(), State.Significance, InterestLocations);
+		}
+
+		if (NewSignificance != State.Significance)
+		{
+			State.Significance = NewSignificance;
+			ApplySignificance(Character, NewSignificance);
+		}
+
+		if (IsThrottleable(Character))
+		{
+			TierCounts[(int32)State.Significance]++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_GDKNPCsHigh, TierCounts[(int32)ENPCSignificance::High]);
+	SET_DWORD_STAT(STAT_GDKNPCsMedium, TierCounts[(int32)ENPCSignificance::Medium]);
+	SET_DWORD_STAT(STAT_GDKNPCsLow, TierCounts[(int32)ENPCSignificance::Low]);
+}
+
+ENPCSignificance UNPCSignificanceComponent::Classify(const FVector& Location, ENPCSignificance CurrentSignificance, const TArray<FVector>& InterestLocations) const
+{
+	float ClosestDistanceSquared = MAX_flt;
+	for (const FVector& InterestLocation : InterestLocations)
+	{
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(Location, InterestLocation));
+	}
+	const float ClosestDistance = FMath::Sqrt(ClosestDistanceSquared);
+
+	for (const ENPCSignificance Significance : { ENPCSignificance::High, ENPCSignificance::Medium })
+	{
+		// An NPC already in or above the tier only leaves it once past the hysteresis distance.
+		const float Hysteresis = CurrentSignificance <= Significance ? DemotionHysteresis : 0.f;
+		if (ClosestDistance < GetTier(Significance).MaxDistance + Hysteresis)
+		{
+			return Significance;
+		}
+	}
+
+	return ENPCSignificance::Low;
+}
+
+void UNPCSignificanceComponent::ApplySignificance(AGDKCharacter* Character, ENPCSignificance Significance) const
+{
+	const FNPCSignificanceTier& Tier = GetTier(Significance);
+
+	Character->SetActorTickInterval(Tier.TickInterval);
+	Character->GetCharacterMovement()->SetComponentTickInterval(Tier.TickInterval);
+	Character->GetMesh()->SetComponentTickInterval(Tier.TickInterval);
+
+	if (AAIController* AIController = Cast<AAIController>(Character->GetController()))
+	{
+		if (UBrainComponent* BrainComponent = AIController->GetBrainComponent())
+		{
+			BrainComponent->SetComponentTickInterval(Tier.BehaviorTreeTickInterval);
+		}
+
+		if (UAIPerceptionComponent* PerceptionComponent = AIController->GetPerceptionComponent())
+		{
+			PerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), Tier.bSightEnabled);
+		}
+	}
+}
+
+bool UNPCSignificanceComponent::IsThrottleable(const AGDKCharacter* Character) const
+{
+	return Character->HasAuthority() && Cast<AAIController>(Character->GetController()) != nullptr;
+}
+
+const FNPCSignificanceTier& UNPCSignificanceComponent::GetTier(ENPCSignificance Significance) const
+{
+	switch (Significance)
+	{
+	case ENPCSignificance::High:
+		return HighSignificance;
+	case ENPCSignificance::Medium:
+		return MediumSignificance;
+	default:
+		return LowSignificance;
+	}
+}
@@ -0,0 +1,210 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/PerceptionRegistryComponent.h"
+#include "Characters/Components/HealthComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "GDKStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Find Hostiles"), STAT_GDKFindHostiles, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hostile Candidates Checked"), STAT_GDKHostileCandidatesChecked, STATGROUP_GDKShooter);
+
+static const FIntPoint InvalidCell(MAX_int32, MAX_int32);
+
+UPerceptionRegistryComponent::UPerceptionRegistryComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UPerceptionRegistryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(RefreshTimerHandle, this, &UPerceptionRegistryComponent::RefreshGrid, RefreshInterval, true);
+}
+
+void UPerceptionRegistryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(RefreshTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UPerceptionRegistryComponent* UPerceptionRegistryComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<UPerceptionRegistryComponent>(WorldContextObject);
+}
+
+void UPerceptionRegistryComponent::RegisterActor(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	const FGenericTeamId TeamId = UGDKShooterFunctionLibrary::GetGenericTeamId(Actor);
+	if (RegisteredActors.Contains(Actor))
+	{
+		UpdateTeam(Actor, TeamId);
+		return;
+	}
+
+	FRegisteredActor& Registered = RegisteredActors.Add(Actor);
+	Registered.Team = TeamId;
+	Registered.Cell = GetCell(Actor->GetActorLocation());
+	AddToCell(Actor, TeamId, Registered.Cell);
+}
+
+void UPerceptionRegistryComponent::UnregisterActor(AActor* Actor)
+{
+	FRegisteredActor Registered;
+	if (RegisteredActors.RemoveAndCopyValue(Actor, Registered))
+	{
+		RemoveFromCell(Actor, Registered.Team, Registered.Cell);
+	}
+}
+
+void UPerceptionRegistryComponent::UpdateTeam(AActor* Actor, FGenericTeamId NewTeamId)
+{
+	FRegisteredActor* Registered = RegisteredActors.Find(Actor);
+	if (Registered != nullptr && Registered->Team != NewTeamId)
+	{
+		RemoveFromCell(Actor, Registered->Team, Registered->Cell);
+		AddToCell(Actor, NewTeamId, Registered->Cell);
+		Registered->Team = NewTeamId;
+	}
+}
+
+FIntPoint UPerceptionRegistryComponent::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UPerceptionRegistryComponent::AddToCell(const TWeakObjectPtr<AActor>& Actor, FGenericTeamId Team, const FIntPoint& Cell)
+{
+	if (Cell != InvalidCell)
+	{
+		TeamGrids.FindOrAdd(Team.GetId()).FindOrAdd(Cell).Add(Actor);
+	}
+}
+
+void UPerceptionRegistryComponent::RemoveFromCell(const TWeakObjectPtr<AActor>& Actor, FGenericTeamId Team, const FIntPoint& Cell)
+{
+	if (Cell == InvalidCell)
+	{
+		return;
+	}
+
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AActor>>>* Grid = TeamGrids.Find(Team.GetId());
+	if (Grid == nullptr)
+	{
+		return;
+	}
+
+	if (TArray<TWeakObjectPtr<AActor>>* Actors = Grid->Find(Cell))
+	{
+		Actors->RemoveSingleSwap(Actor);
+		if (Actors->Num() == 0)
+		{
+			Grid->Remove(Cell);
+		}
+	}
+}
+
+void UPerceptionRegistryComponent::RefreshGrid()
+{
+	for (auto It = RegisteredActors.CreateIterator(); It; ++It)
+	{
+		AActor* Actor = It.Key().Get();
+		if (Actor == nullptr)
+		{
+			// Destroyed without ending play on this worker.
+			RemoveFromCell(It.Key(), It.Value().Team, It.Value().Cell);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const UHealthComponent* Health = Actor->FindComponentByClass<UHealthComponent>();
+		// Hidden characters are parked in the UCharacterPoolComponent.
+		const bool bIsAlive = !Actor->IsHidden() && (Health == nullptr || Health->GetCurrentHealth() > 0.f);
+		const FIntPoint NewCell = bIsAlive ? GetCell(Actor->GetActorLocation()) : InvalidCell;
+		// Team changes only reach other workers through replication.
+		const FGenericTeamId NewTeam = UGDKShooterFunctionLibrary::GetGenericTeamId(Actor);
+
+		if (NewCell != It.Value().Cell || NewTeam != It.Value().Team)
+		{
+			RemoveFromCell(It.Key(), It.Value().Team, It.Value().Cell);
+			AddToCell(It.Key(), NewTeam, NewCell);
+			It.Value().Cell = NewCell;
+			It.Value().Team = NewTeam;
+		}
+	}
+}
+
+void UPerceptionRegistryComponent::FindHostilesNear(const AActor* Querier, float Radius, TArray<AActor*>& OutHostiles) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKFindHostiles);
+
+	OutHostiles.Reset();
+	if (Querier == nullptr)
+	{
+		return;
+	}
+
+	const FGenericTeamId QuerierTeam = UGDKShooterFunctionLibrary::GetGenericTeamId(const_cast<AActor*>(Querier));
+	const FVector Location = Querier->GetActorLocation();
+	const FIntPoint MinCell = GetCell(Location - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Location + FVector(Radius));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	TArray<TPair<float, AActor*>> Candidates;
+	int32 NumChecked = 0;
+
+	for (const TPair<uint8, TMap<FIntPoint, TArray<TWeakObjectPtr<AActor>>>>& TeamGrid : TeamGrids)
+	{
+		if (FGenericTeamId::GetAttitude(QuerierTeam, FGenericTeamId(TeamGrid.Key)) != ETeamAttitude::Hostile)
+		{
+			continue;
+		}
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				const TArray<TWeakObjectPtr<AActor>>* Actors = TeamGrid.Value.Find(FIntPoint(X, Y));
+				if (Actors == nullptr)
+				{
+					continue;
+				}
+
+				for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+				{
+					NumChecked++;
+					if (Actor.IsValid() && Actor.Get() != Querier)
+					{
+						const float DistanceSquared = FVector::DistSquared(Location, Actor->GetActorLocation());
+						if (DistanceSquared <= RadiusSquared)
+						{
+							Candidates.Emplace(DistanceSquared, Actor.Get());
+						}
+					}
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_GDKHostileCandidatesChecked, NumChecked);
+
+	Candidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+	OutHostiles.Reserve(Candidates.Num());
+	for (const TPair<float, AActor*>& Candidate : Candidates)
+	{
+		OutHostiles.Add(Candidate.Value);
+	}
+}
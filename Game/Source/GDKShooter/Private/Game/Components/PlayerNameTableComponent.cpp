@@ -0,0 +1,125 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/PlayerNameTableComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "Net/UnrealNetwork.h"
+
+UPlayerNameTableComponent::UPlayerNameTableComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UPlayerNameTableComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UPlayerNameTableComponent, Names);
+}
+
+void UPlayerNameTableComponent::RegisterPlayer(APlayerState* PlayerState)
+{
+	if (PlayerState == nullptr || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	const FString& NewName = PlayerState->GetPlayerName();
+
+	if (int32* Index = NameIndexMap.Find(PlayerState->PlayerId))
+	{
+		if (Names[*Index].PlayerName.Equals(NewName, ESearchCase::CaseSensitive))
+		{
+			// Nothing changed, don't dirty the replicated array.
+			return;
+		}
+		Names[*Index].PlayerName = NewName;
+	}
+	else
+	{
+		FPlayerNameEntry NewEntry;
+		NewEntry.PlayerId = PlayerState->PlayerId;
+		NewEntry.PlayerName = NewName;
+
+		int32 NewIndex = Names.Add(NewEntry);
+		NameIndexMap.Emplace(NewEntry.PlayerId, NewIndex);
+	}
+
+	NamesChanged.Broadcast();
+}
+
+FString UPlayerNameTableComponent::GetPlayerName(int32 PlayerId) const
+{
+	const FString* Name = FindPlayerName(PlayerId);
+	return Name ? *Name : FString();
+}
+
+const FString* UPlayerNameTableComponent::FindPlayerName(int32 PlayerId) const
+{
+	if (const int32* Index = NameIndexMap.Find(PlayerId))
+	{
+		return &Names[*Index].PlayerName;
+	}
+	return nullptr;
+}
+
+UPlayerNameTableComponent* UPlayerNameTableComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<UPlayerNameTableComponent>(WorldContextObject);
+}
+
+FString UPlayerNameTableComponent::ResolvePlayerName(const UObject* WorldContextObject, int32 PlayerId)
+{
+	if (const UPlayerNameTableComponent* NameTable = Get(WorldContextObject))
+	{
+		if (const FString* Name = NameTable->FindPlayerName(PlayerId))
+		{
+			return *Name;
+		}
+	}
+
+	const APlayerState* PlayerState = FindPlayerState(WorldContextObject, PlayerId);
+	return PlayerState ? PlayerState->GetPlayerName() : FString();
+}
+
+const APlayerState* UPlayerNameTableComponent::FindPlayerState(const UObject* WorldContextObject, int32 PlayerId)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr || World->GetGameState() == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (const APlayerState* PlayerState : World->GetGameState()->PlayerArray)
+	{
+		if (PlayerState != nullptr && PlayerState->PlayerId == PlayerId)
+		{
+			return PlayerState;
+		}
+	}
+	return nullptr;
+}
+
+void UPlayerNameTableComponent::RestoreEntries(const TArray<FPlayerNameEntry>& Entries)
+{
+	Names = Entries;
+	RebuildIndex();
+	NamesChanged.Broadcast();
+}
+
+void UPlayerNameTableComponent::RebuildIndex()
+{
+	NameIndexMap.Reset();
+	for (int32 i = 0; i < Names.Num(); i++)
+	{
+		NameIndexMap.Emplace(Names[i].PlayerId, i);
+	}
+}
+
+void UPlayerNameTableComponent::OnRep_Names()
+{
+	RebuildIndex();
+	NamesChanged.Broadcast();
+}
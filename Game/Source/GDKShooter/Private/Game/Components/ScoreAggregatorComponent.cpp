@@ -0,0 +1,184 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/ScoreAggregatorComponent.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/World.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Game/Components/DeathmatchScoreComponent.h"
+#include "Game/Components/ScorePublisher.h"
+#include "Game/Components/TeamDeathmatchScoreComponent.h"
+#include "GDKLogging.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
+
+UScoreAggregatorComponent::UScoreAggregatorComponent()
+	: LocalWorkerEpoch(0)
+	, NextSequence(1)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UScoreAggregatorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	LocalWorkerId = TEXT("local");
+	if (USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(GetNetDriver()))
+	{
+		if (SpatialNetDriver->Connection != nullptr)
+		{
+			LocalWorkerId = SpatialNetDriver->Connection->GetWorkerId();
+		}
+	}
+	LocalWorkerEpoch = FDateTime::UtcNow().GetTicks();
+
+	if (UScorePublisher* ScorePublisher = GetOwner()->FindComponentByClass<UScorePublisher>())
+	{
+		ScorePublisher->KillEvent.AddDynamic(this, &UScoreAggregatorComponent::RecordKill);
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(FlushTimerHandle, this, &UScoreAggregatorComponent::Flush, FlushInterval, true);
+}
+
+void UScoreAggregatorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(FlushTimerHandle);
+	Flush();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UScoreAggregatorComponent::RecordKill(APlayerState* KillerState, APlayerState* VictimState)
+{
+	const int32 KillerId = KillerState != nullptr ? KillerState->PlayerId : -1;
+	const int32 VictimId = VictimState != nullptr ? VictimState->PlayerId : -1;
+
+	// Matches the score components: suicides count as a death but not a kill.
+	if (KillerId != -1 && KillerId != VictimId)
+	{
+		FindOrAddDelta(KillerId).Kills++;
+	}
+	if (VictimId != -1)
+	{
+		FindOrAddDelta(VictimId).Deaths++;
+	}
+}
+
+FPlayerScoreDelta& UScoreAggregatorComponent::FindOrAddDelta(int32 PlayerId)
+{
+	if (int32* Index = PendingDeltaIndex.Find(PlayerId))
+	{
+		return PendingDeltas[*Index];
+	}
+
+	int32 NewIndex = PendingDeltas.AddDefaulted();
+	PendingDeltas[NewIndex].PlayerId = PlayerId;
+	PendingDeltaIndex.Emplace(PlayerId, NewIndex);
+	return PendingDeltas[NewIndex];
+}
+
+void UScoreAggregatorComponent::Flush()
+{
+	if (PendingDeltas.Num() == 0)
+	{
+		return;
+	}
+
+	if (GetOwner()->HasAuthority())
+	{
+		// We own the scores, no need to go through the runtime.
+		ApplyDeltasToScores(PendingDeltas);
+	}
+	else
+	{
+		FScoreDeltaBatch Batch;
+		Batch.WorkerId = LocalWorkerId;
+		Batch.WorkerEpoch = LocalWorkerEpoch;
+		Batch.Sequence = NextSequence++;
+		Batch.Deltas = MoveTemp(PendingDeltas);
+
+		ApplyScoreDeltas(Batch);
+	}
+
+	PendingDeltas.Reset();
+	PendingDeltaIndex.Reset();
+}
+
+void UScoreAggregatorComponent::ApplyScoreDeltas_Implementation(const FScoreDeltaBatch& Batch)
+{
+	if (!MarkBatchApplied(Batch))
+	{
+		// Already applied, e.g. redelivered after an authority change.
+		UE_LOG(LogGDK, Verbose, TEXT("Dropping duplicate score batch %d from %s"), Batch.Sequence, *Batch.WorkerId);
+		return;
+	}
+
+	ApplyDeltasToScores(Batch.Deltas);
+}
+
+bool UScoreAggregatorComponent::MarkBatchApplied(const FScoreDeltaBatch& Batch)
+{
+	FAppliedScoreBatches* Applied = AppliedBatches.FindByPredicate([&Batch](const FAppliedScoreBatches& Entry)
+	{
+		return Entry.WorkerEpoch == Batch.WorkerEpoch && Entry.WorkerId == Batch.WorkerId;
+	});
+	if (Applied == nullptr)
+	{
+		Applied = &AppliedBatches.AddDefaulted_GetRef();
+		Applied->WorkerId = Batch.WorkerId;
+		Applied->WorkerEpoch = Batch.WorkerEpoch;
+	}
+
+	// Batches can arrive out of order, so anything above the contiguous run is tracked individually.
+	if (Batch.Sequence <= Applied->ContiguousSequence)
+	{
+		return false;
+	}
+
+	const int32 InsertIndex = Algo::LowerBound(Applied->AppliedAfterGap, Batch.Sequence);
+	if (Applied->AppliedAfterGap.IsValidIndex(InsertIndex) && Applied->AppliedAfterGap[InsertIndex] == Batch.Sequence)
+	{
+		return false;
+	}
+	Applied->AppliedAfterGap.Insert(Batch.Sequence, InsertIndex);
+
+	if (Applied->AppliedAfterGap.Num() > FMath::Max(MaxBatchesAfterGap, 1))
+	{
+		// Batches are sent reliably, so a gap this long means the missing ones aren't coming.
+		UE_LOG(LogGDK, Warning, TEXT("Giving up on score batches %d to %d from %s"), Applied->ContiguousSequence + 1, Applied->AppliedAfterGap[0] - 1, *Batch.WorkerId);
+		Applied->ContiguousSequence = Applied->AppliedAfterGap[0] - 1;
+	}
+
+	int32 NumContiguous = 0;
+	while (NumContiguous < Applied->AppliedAfterGap.Num() && Applied->AppliedAfterGap[NumContiguous] == Applied->ContiguousSequence + 1)
+	{
+		Applied->ContiguousSequence++;
+		NumContiguous++;
+	}
+	Applied->AppliedAfterGap.RemoveAt(0, NumContiguous, false);
+
+	return true;
+}
+
+void UScoreAggregatorComponent::ApplyDeltasToScores(const TArray<FPlayerScoreDelta>& Deltas)
+{
+	UDeathmatchScoreComponent* DeathmatchScore = GetOwner()->FindComponentByClass<UDeathmatchScoreComponent>();
+	UTeamDeathmatchScoreComponent* TeamDeathmatchScore = GetOwner()->FindComponentByClass<UTeamDeathmatchScoreComponent>();
+
+	for (const FPlayerScoreDelta& Delta : Deltas)
+	{
+		if (DeathmatchScore != nullptr)
+		{
+			DeathmatchScore->ApplyScoreDelta(Delta.PlayerId, Delta.Kills, Delta.Deaths);
+		}
+		if (TeamDeathmatchScore != nullptr)
+		{
+			TeamDeathmatchScore->ApplyScoreDelta(Delta.PlayerId, Delta.Kills, Delta.Deaths);
+		}
+	}
+}
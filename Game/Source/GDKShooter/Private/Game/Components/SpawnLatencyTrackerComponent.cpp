@@ -0,0 +1,156 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/SpawnLatencyTrackerComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GDKLogging.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorld SpawnLatencyStatsCommand(
+	TEXT("GDK.SpawnLatency.Stats"),
+	TEXT("Logs the per stage spawn latency histograms."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		if (const USpawnLatencyTrackerComponent* Tracker = USpawnLatencyTrackerComponent::Get(World))
+		{
+			Tracker->LogStats();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld SpawnLatencyDumpCsvCommand(
+	TEXT("GDK.SpawnLatency.DumpCsv"),
+	TEXT("Writes the per stage spawn latency histograms to a CSV file in Saved/Profiling."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		if (const USpawnLatencyTrackerComponent* Tracker = USpawnLatencyTrackerComponent::Get(World))
+		{
+			Tracker->DumpCsv();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld SpawnLatencyResetCommand(
+	TEXT("GDK.SpawnLatency.Reset"),
+	TEXT("Clears the spawn latency histograms."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		if (USpawnLatencyTrackerComponent* Tracker = USpawnLatencyTrackerComponent::Get(World))
+		{
+			Tracker->Reset();
+		}
+	}));
+
+USpawnLatencyTrackerComponent::USpawnLatencyTrackerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	StageHistograms.SetNum((int32)ESpawnStage::Count);
+}
+
+USpawnLatencyTrackerComponent* USpawnLatencyTrackerComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<USpawnLatencyTrackerComponent>(WorldContextObject);
+}
+
+void USpawnLatencyTrackerComponent::RecordStage(const UObject* WorldContextObject, const AController* Controller, ESpawnStage Stage)
+{
+	if (Controller == nullptr)
+	{
+		return;
+	}
+
+	if (USpawnLatencyTrackerComponent* Tracker = Get(WorldContextObject))
+	{
+		Tracker->Record(Controller, Stage);
+	}
+}
+
+void USpawnLatencyTrackerComponent::RecordClientLatency(const UObject* WorldContextObject, double Seconds)
+{
+	if (USpawnLatencyTrackerComponent* Tracker = Get(WorldContextObject))
+	{
+		Tracker->StageHistograms[(int32)ESpawnStage::ClientPossessed].Add(Seconds * 1000.0);
+	}
+}
+
+void USpawnLatencyTrackerComponent::Record(const AController* Controller, ESpawnStage Stage)
+{
+	const double Now = FPlatformTime::Seconds();
+	const int32 StageIndex = (int32)Stage;
+
+	if (Stage == ESpawnStage::Requested)
+	{
+		FSpawnTimeline& Timeline = Timelines.FindOrAdd(Controller);
+		Timeline.StageTimes[StageIndex] = Now;
+		Timeline.LastStage = StageIndex;
+		return;
+	}
+
+	FSpawnTimeline* Timeline = Timelines.Find(Controller);
+	if (Timeline == nullptr || StageIndex <= Timeline->LastStage)
+	{
+		// Not part of a tracked spawn, e.g. a pooled character being re-equipped twice.
+		return;
+	}
+
+	StageHistograms[StageIndex].Add((Now - Timeline->StageTimes[Timeline->LastStage]) * 1000.0);
+	Timeline->StageTimes[StageIndex] = Now;
+	Timeline->LastStage = StageIndex;
+
+	if (Stage == ESpawnStage::Equipped)
+	{
+		ServerTotalHistogram.Add((Now - Timeline->StageTimes[(int32)ESpawnStage::Requested]) * 1000.0);
+		Timelines.Remove(Controller);
+	}
+}
+
+void USpawnLatencyTrackerComponent::LogStats() const
+{
+	const UEnum* StageEnum = StaticEnum<ESpawnStage>();
+	for (int32 i = 0; i < StageHistograms.Num(); i++)
+	{
+		if (StageHistograms[i].GetCount() > 0)
+		{
+			UE_LOG(LogGDK, Log, TEXT("Spawn %s ms: %s"), *StageEnum->GetNameStringByIndex(i), *StageHistograms[i].ToString());
+		}
+	}
+	UE_LOG(LogGDK, Log, TEXT("Spawn server total ms: %s"), *ServerTotalHistogram.ToString());
+	UE_LOG(LogGDK, Log, TEXT("Spawns in progress: %d"), Timelines.Num());
+}
+
+FString USpawnLatencyTrackerComponent::DumpCsv() const
+{
+	const UEnum* StageEnum = StaticEnum<ESpawnStage>();
+
+	FString Csv = FGDKHistogram::GetCsvHeader() + LINE_TERMINATOR;
+	for (int32 i = 0; i < StageHistograms.Num(); i++)
+	{
+		Csv += StageHistograms[i].ToCsvRow(StageEnum->GetNameStringByIndex(i)) + LINE_TERMINATOR;
+	}
+	Csv += ServerTotalHistogram.ToCsvRow(TEXT("ServerTotal")) + LINE_TERMINATOR;
+
+	const FString NetModeName = GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server");
+	const FString Path = FPaths::Combine(FPaths::ProfilingDir(), FString::Printf(TEXT("SpawnLatency-%s-%s.csv"), *NetModeName, *FDateTime::Now().ToString()));
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogGDK, Warning, TEXT("Failed to write spawn latency CSV to %s"), *Path);
+		return FString();
+	}
+
+	UE_LOG(LogGDK, Log, TEXT("Wrote spawn latency CSV to %s"), *Path);
+	return Path;
+}
+
+void USpawnLatencyTrackerComponent::Reset()
+{
+	for (FGDKHistogram& Histogram : StageHistograms)
+	{
+		Histogram.Reset();
+	}
+	ServerTotalHistogram.Reset();
+	Timelines.Reset();
+}
@@ -1,10 +1,116 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #include "Game/Components/SpawnRequestPublisher.h"
+#include "Game/Components/SpawnLatencyTrackerComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GDKLogging.h"
+#include "GDKStats.h"
+#include "HAL/IConsoleManager.h"
 
+DECLARE_CYCLE_STAT(TEXT("Spawn Queue"), STAT_GDKSpawnQueue, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawn Queue Depth"), STAT_GDKSpawnQueueDepth, STATGROUP_GDKShooter);
+
+static FAutoConsoleCommandWithWorld SpawnQueueStatsCommand(
+	TEXT("GDK.SpawnQueue.Stats"),
+	TEXT("Logs the spawn queue depth and wait time histograms."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		if (World != nullptr && World->GetGameState() != nullptr)
+		{
+			if (const USpawnRequestPublisher* Publisher = World->GetGameState()->FindComponentByClass<USpawnRequestPublisher>())
+			{
+				Publisher->LogQueueStats();
+			}
+		}
+	}));
 
 USpawnRequestPublisher::USpawnRequestPublisher()
+	: QueueDepthHistogram(1.0, 1.25, 40)
+	, WaitTimeHistogram(1.0, 1.25, 48)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void USpawnRequestPublisher::RequestSpawn(APlayerController* Controller)
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	if (!bUseSpawnQueue)
+	{
+		PublishRequest(Controller);
+		return;
+	}
+
+	if (Controller == nullptr || QueuedControllers.Contains(Controller))
+	{
+		return;
+	}
+
+	FQueuedSpawnRequest Request;
+	Request.Controller = Controller;
+	Request.EnqueueTime = FPlatformTime::Seconds();
+	SpawnQueue.Add(Request);
+	QueuedControllers.Add(Controller);
+
+	SET_DWORD_STAT(STAT_GDKSpawnQueueDepth, SpawnQueue.Num());
+	SetComponentTickEnabled(true);
 }
 
+void USpawnRequestPublisher::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SCOPE_CYCLE_COUNTER(STAT_GDKSpawnQueue);
+
+	QueueDepthHistogram.Add(SpawnQueue.Num());
+
+	const double FrameStartTime = FPlatformTime::Seconds();
+	int32 EntitiesThisFrame = 0;
+	int32 NumPublished = 0;
+
+	while (NumPublished < SpawnQueue.Num())
+	{
+		const FQueuedSpawnRequest& Request = SpawnQueue[NumPublished];
+		const double Now = FPlatformTime::Seconds();
+		const bool bOverBudget = (Now - FrameStartTime) * 1000.0 >= FrameTimeBudgetMs || EntitiesThisFrame + EstimatedEntitiesPerSpawn > FrameEntityBudget;
+		const bool bOverdue = Now - Request.EnqueueTime >= MaxQueueLatency;
+
+		// Always publish at least one request per frame, so a small budget can't stall the queue.
+		if (NumPublished > 0 && bOverBudget && !bOverdue)
+		{
+			break;
+		}
+
+		WaitTimeHistogram.Add((Now - Request.EnqueueTime) * 1000.0);
+		QueuedControllers.Remove(Request.Controller);
+
+		if (APlayerController* Controller = Request.Controller.Get())
+		{
+			PublishRequest(Controller);
+			EntitiesThisFrame += EstimatedEntitiesPerSpawn;
+		}
+
+		NumPublished++;
+	}
+
+	SpawnQueue.RemoveAt(0, NumPublished, false);
+	SET_DWORD_STAT(STAT_GDKSpawnQueueDepth, SpawnQueue.Num());
+
+	if (SpawnQueue.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void USpawnRequestPublisher::PublishRequest(APlayerController* Controller)
+{
+	USpawnLatencyTrackerComponent::RecordStage(this, Controller, ESpawnStage::Published);
+	OnSpawnRequest.Broadcast(Controller);
+}
+
+void USpawnRequestPublisher::LogQueueStats() const
+{
+	UE_LOG(LogGDK, Log, TEXT("Spawn queue depth: %d (%s)"), SpawnQueue.Num(), *QueueDepthHistogram.ToString());
+	UE_LOG(LogGDK, Log, TEXT("Spawn queue wait ms: %s"), *WaitTimeHistogram.ToString());
+}
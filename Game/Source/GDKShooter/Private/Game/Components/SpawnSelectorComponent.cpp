@@ -0,0 +1,306 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Game/Components/SpawnSelectorComponent.h"
+#include "Characters/GDKCharacter.h"
+#include "Characters/Components/HealthComponent.h"
+#include "Characters/Components/TeamComponent.h"
+#include "Engine/PlayerStartPIE.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GDKRandom.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "GDKStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Select Spawn Point"), STAT_GDKSelectSpawnPoint, STATGROUP_GDKShooter);
+
+static const FIntPoint InvalidCell(MAX_int32, MAX_int32);
+
+USpawnSelectorComponent::USpawnSelectorComponent()
+	: bHasPlayerStartPIE(false)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void USpawnSelectorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		if (It->IsA<APlayerStartPIE>())
+		{
+			bHasPlayerStartPIE = true;
+		}
+		else
+		{
+			PlayerStarts.Add(*It);
+		}
+	}
+
+	// Shuffle once, so consecutive runs of candidates are spread over the map.
+	for (int32 i = PlayerStarts.Num() - 1; i > 0; --i)
+	{
+		PlayerStarts.Swap(i, FGDKRandom::GetStream(EGDKRandomStream::Spawn).RandRange(0, i));
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(RefreshTimerHandle, this, &USpawnSelectorComponent::RefreshGrid, RefreshInterval, true);
+}
+
+void USpawnSelectorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(RefreshTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+USpawnSelectorComponent* USpawnSelectorComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<USpawnSelectorComponent>(WorldContextObject);
+}
+
+void USpawnSelectorComponent::RegisterCharacter(AGDKCharacter* Character)
+{
+	if (Character == nullptr || CharacterCells.Contains(Character))
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(Character->GetActorLocation());
+	CharacterCells.Add(Character, Cell);
+	Grid.FindOrAdd(Cell).Add(Character);
+}
+
+void USpawnSelectorComponent::UnregisterCharacter(AGDKCharacter* Character)
+{
+	FIntPoint Cell;
+	if (CharacterCells.RemoveAndCopyValue(Character, Cell))
+	{
+		RemoveFromCell(Character, Cell);
+	}
+}
+
+void USpawnSelectorComponent::RemoveFromCell(AGDKCharacter* Character, const FIntPoint& Cell)
+{
+	if (Cell == InvalidCell)
+	{
+		return;
+	}
+
+	if (TArray<TWeakObjectPtr<AGDKCharacter>>* Characters = Grid.Find(Cell))
+	{
+		Characters->RemoveSingleSwap(Character);
+		if (Characters->Num() == 0)
+		{
+			Grid.Remove(Cell);
+		}
+	}
+}
+
+FIntPoint USpawnSelectorComponent::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void USpawnSelectorComponent::RefreshGrid()
+{
+	for (auto It = CharacterCells.CreateIterator(); It; ++It)
+	{
+		AGDKCharacter* Character = It.Key().Get();
+		if (Character == nullptr)
+		{
+			// Destroyed without ending play on this worker.
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const UHealthComponent* Health = Character->FindComponentByClass<UHealthComponent>();
+		// Hidden characters are parked in the UCharacterPoolComponent.
+		const bool bIsAlive = !Character->IsHidden() && (Health == nullptr || Health->GetCurrentHealth() > 0.f);
+		const FIntPoint NewCell = bIsAlive ? GetCell(Character->GetActorLocation()) : InvalidCell;
+
+		if (NewCell != It.Value())
+		{
+			RemoveFromCell(Character, It.Value());
+			if (NewCell != InvalidCell)
+			{
+				Grid.FindOrAdd(NewCell).Add(Character);
+			}
+			It.Value() = NewCell;
+		}
+	}
+
+	// Drop cells left behind by destroyed characters.
+	for (auto It = Grid.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAllSwap([](const TWeakObjectPtr<AGDKCharacter>& Character) { return !Character.IsValid(); });
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool USpawnSelectorComponent::IsEnemy(const AGDKCharacter* Character, const FGenericTeamId& Team) const
+{
+	const FGenericTeamId OtherTeam = Character->GetGenericTeamId();
+	return Team == FGenericTeamId::NoTeam || OtherTeam == FGenericTeamId::NoTeam || OtherTeam != Team;
+}
+
+float USpawnSelectorComponent::ScoreProximity(const FVector& Location, const FGenericTeamId& Team, TArray<AGDKCharacter*>& OutNearbyEnemies) const
+{
+	float Score = 0.f;
+	const float DangerRadiusSquared = DangerRadius * DangerRadius;
+	const FIntPoint MinCell = GetCell(Location - FVector(DangerRadius, DangerRadius, 0.f));
+	const FIntPoint MaxCell = GetCell(Location + FVector(DangerRadius, DangerRadius, 0.f));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<TWeakObjectPtr<AGDKCharacter>>* Characters = Grid.Find(FIntPoint(X, Y));
+			if (Characters == nullptr)
+			{
+				continue;
+			}
+
+			for (const TWeakObjectPtr<AGDKCharacter>& WeakCharacter : *Characters)
+			{
+				AGDKCharacter* Character = WeakCharacter.Get();
+				if (Character == nullptr || !IsEnemy(Character, Team))
+				{
+					continue;
+				}
+
+				const float DistanceSquared = FVector::DistSquared(Location, Character->GetActorLocation());
+				if (DistanceSquared < DangerRadiusSquared)
+				{
+					// Quadratic falloff, so enemies right next to a start dominate the score.
+					const float Closeness = 1.f - FMath::Sqrt(DistanceSquared) / DangerRadius;
+					Score += Closeness * Closeness;
+					OutNearbyEnemies.Add(Character);
+				}
+			}
+		}
+	}
+
+	return Score;
+}
+
+APlayerStart* USpawnSelectorComponent::SelectSpawnPoint(AController* Controller)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKSelectSpawnPoint);
+
+	// Leave "Play From Here" to the game mode.
+	if (bHasPlayerStartPIE || PlayerStarts.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	FGenericTeamId Team = FGenericTeamId::NoTeam;
+	if (Controller != nullptr && Controller->PlayerState != nullptr)
+	{
+		if (const UTeamComponent* TeamComponent = Controller->PlayerState->FindComponentByClass<UTeamComponent>())
+		{
+			Team = TeamComponent->GetTeam();
+		}
+	}
+
+	struct FCandidate
+	{
+		APlayerStart* Start;
+		float Score;
+		TArray<AGDKCharacter*> NearbyEnemies;
+	};
+
+	// Score a bounded run of starts from a random offset.
+	const int32 NumCandidates = FMath::Min(MaxCandidates, PlayerStarts.Num());
+	const int32 Offset = FGDKRandom::GetStream(EGDKRandomStream::Spawn).RandRange(0, PlayerStarts.Num() - 1);
+
+	TArray<FCandidate, TInlineAllocator<32>> Candidates;
+	for (int32 i = 0; i < NumCandidates; i++)
+	{
+		APlayerStart* Start = PlayerStarts[(Offset + i) % PlayerStarts.Num()];
+		if (Start == nullptr)
+		{
+			continue;
+		}
+
+		FCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+		Candidate.Start = Start;
+		Candidate.Score = ScoreProximity(Start->GetActorLocation(), Team, Candidate.NearbyEnemies);
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	Candidates.Sort([](const FCandidate& Lhs, const FCandidate& Rhs) { return Lhs.Score < Rhs.Score; });
+
+	// Walk the candidates safest first, tracing from nearby enemies until we find one nobody can see or run out of traces.
+	int32 TracesLeft = MaxLineOfSightChecks;
+	for (FCandidate& Candidate : Candidates)
+	{
+		if (Candidate.NearbyEnemies.Num() == 0)
+		{
+			return Candidate.Start;
+		}
+
+		const FVector Target = Candidate.Start->GetActorLocation();
+		bool bIsVisible = false;
+		int32 EnemiesChecked = 0;
+		for (AGDKCharacter* Enemy : Candidate.NearbyEnemies)
+		{
+			if (TracesLeft <= 0)
+			{
+				break;
+			}
+			TracesLeft--;
+			EnemiesChecked++;
+
+			FVector EyeLocation;
+			FRotator EyeRotation;
+			Enemy->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(SpawnSelectorLineOfSight), false, Enemy);
+			if (!GetWorld()->LineTraceTestByChannel(EyeLocation, Target, LineOfSightCollisionChannel.GetValue(), Params))
+			{
+				bIsVisible = true;
+				break;
+			}
+		}
+
+		if (bIsVisible)
+		{
+			Candidate.Score += LineOfSightPenalty;
+		}
+		else if (EnemiesChecked == Candidate.NearbyEnemies.Num())
+		{
+			// Every nearby enemy was checked and none can see it, and later candidates are no safer.
+			return Candidate.Start;
+		}
+
+		if (TracesLeft <= 0)
+		{
+			break;
+		}
+	}
+
+	const FCandidate* Best = &Candidates[0];
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (Candidate.Score < Best->Score)
+		{
+			Best = &Candidate;
+		}
+	}
+	return Best->Start;
+}
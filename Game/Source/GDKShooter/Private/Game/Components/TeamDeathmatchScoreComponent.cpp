@@ -4,6 +4,7 @@
 #include "Game/Components/TeamDeathmatchScoreComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "Characters/Components/TeamComponent.h"
+#include "Game/Components/PlayerNameTableComponent.h"
 
 UTeamDeathmatchScoreComponent::UTeamDeathmatchScoreComponent()
 {
@@ -11,6 +12,16 @@ UTeamDeathmatchScoreComponent::UTeamDeathmatchScoreComponent()
 	SetIsReplicatedByDefault(true);
 }
 
+void UTeamDeathmatchScoreComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UPlayerNameTableComponent* NameTable = GetOwner()->FindComponentByClass<UPlayerNameTableComponent>())
+	{
+		NameTable->NamesChanged.AddDynamic(this, &UTeamDeathmatchScoreComponent::OnPlayerNamesChanged);
+	}
+}
+
 void UTeamDeathmatchScoreComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -27,6 +38,26 @@ void UTeamDeathmatchScoreComponent::SetTeamScores(TArray<FTeamScore> InitialTeam
 	}
 }
 
+void UTeamDeathmatchScoreComponent::RestoreTeamScores(const TArray<FTeamScore>& Scores)
+{
+	TeamScoreArray = Scores;
+
+	TeamScoreMap.Reset();
+	PlayerScoreMap.Reset();
+	PlayerTeamMap.Reset();
+	for (int32 TeamIndex = 0; TeamIndex < TeamScoreArray.Num(); TeamIndex++)
+	{
+		const FTeamScore& Team = TeamScoreArray[TeamIndex];
+		TeamScoreMap.Emplace(Team.TeamId.GetId(), TeamIndex);
+
+		for (int32 PlayerIndex = 0; PlayerIndex < Team.PlayerScores.Num(); PlayerIndex++)
+		{
+			PlayerScoreMap.Emplace(Team.PlayerScores[PlayerIndex].PlayerId, PlayerIndex);
+			PlayerTeamMap.Emplace(Team.PlayerScores[PlayerIndex].PlayerId, Team.TeamId.GetId());
+		}
+	}
+}
+
 void UTeamDeathmatchScoreComponent::RecordNewPlayer(APlayerState* PlayerState)
 {
 	if (!PlayerScoreMap.Contains(PlayerState->PlayerId))
@@ -35,7 +66,6 @@ void UTeamDeathmatchScoreComponent::RecordNewPlayer(APlayerState* PlayerState)
 		{
 			FPlayerScore NewPlayerScore;
 			NewPlayerScore.PlayerId = PlayerState->PlayerId;
-			NewPlayerScore.PlayerName = PlayerState->GetPlayerName();
 			NewPlayerScore.Kills = 0;
 			NewPlayerScore.Deaths = 0;
 
@@ -60,6 +90,13 @@ void UTeamDeathmatchScoreComponent::RecordNewPlayer(APlayerState* PlayerState)
 				int32 PlayerIndex = TeamScoreArray[TeamScoreMap[TeamId]].PlayerScores.Add(NewPlayerScore);
 				PlayerScoreMap.Emplace(NewPlayerScore.PlayerId, PlayerIndex);
 			}
+
+			PlayerTeamMap.Emplace(NewPlayerScore.PlayerId, TeamId);
+
+			if (UPlayerNameTableComponent* NameTable = GetOwner()->FindComponentByClass<UPlayerNameTableComponent>())
+			{
+				NameTable->RegisterPlayer(PlayerState);
+			}
 		}
 		else
 		{
@@ -88,6 +125,7 @@ void UTeamDeathmatchScoreComponent::RemovePlayer(APlayerState* PlayerState)
 		}
 
 		PlayerScoreMap.Remove(PlayerState->PlayerId);
+		PlayerTeamMap.Remove(PlayerState->PlayerId);
 	}
 }
 
@@ -110,23 +148,45 @@ void UTeamDeathmatchScoreComponent::RecordKill(APlayerState* KillerState, APlaye
 	}
 }
 
+void UTeamDeathmatchScoreComponent::ApplyScoreDelta(int32 PlayerId, int32 Kills, int32 Deaths)
+{
+	const uint8* TeamId = PlayerTeamMap.Find(PlayerId);
+	if (TeamId == nullptr || !TeamScoreMap.Contains(*TeamId))
+	{
+		return;
+	}
+
+	FPlayerScore& Score = TeamScoreArray[TeamScoreMap[*TeamId]].PlayerScores[PlayerScoreMap[PlayerId]];
+	Score.Kills += Kills;
+	Score.Deaths += Deaths;
+}
+
 void UTeamDeathmatchScoreComponent::OnRep_TeamScores()
 {
 	if (GetNetMode() == NM_Client)
 	{
 		for (int32 i = 0; i < TeamScoreArray.Num(); i++)
 		{
-			TeamScoreArray[i].PlayerScores.Sort([](const FPlayerScore& lhs, const FPlayerScore& rhs)
-			{
-				// Sort in reverse order.
-				return lhs.Kills == rhs.Kills ? lhs.Deaths < rhs.Deaths : lhs.Kills > rhs.Kills;
-			});
+			UDeathmatchScoreComponent::SortPlayerScores(TeamScoreArray[i].PlayerScores);
+			UDeathmatchScoreComponent::ResolvePlayerNames(this, TeamScoreArray[i].PlayerScores);
 		}
 	}
 
 	ScoreEvent.Broadcast(TeamScoreArray);
 }
 
+void UTeamDeathmatchScoreComponent::OnPlayerNamesChanged()
+{
+	if (GetNetMode() == NM_Client)
+	{
+		for (FTeamScore& Team : TeamScoreArray)
+		{
+			UDeathmatchScoreComponent::ResolvePlayerNames(this, Team.PlayerScores);
+		}
+		ScoreEvent.Broadcast(TeamScoreArray);
+	}
+}
+
 int32 UTeamDeathmatchScoreComponent::GetTeamScore(FGenericTeamId TeamId)
 {
 	if (TeamScoreMap.Contains(TeamId.GetId()))
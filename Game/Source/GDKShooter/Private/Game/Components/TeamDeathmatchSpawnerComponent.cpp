@@ -7,23 +7,33 @@
 #include "Components/ActorComponent.h"
 #include "EngineUtils.h"
 #include "Engine/World.h"
+#include "EngineClasses/SpatialNetDriver.h"
 #include "GameFramework/PlayerStart.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Game/Components/CharacterPoolComponent.h"
 #include "Game/Components/PlayerPublisher.h"
 #include "GDKLogging.h"
+#include "GDKRandom.h"
+#include "GDKStats.h"
+#include "LoadBalancing/AbstractLBStrategy.h"
 #include "Math/NumericLimits.h"
 #include "Math/UnrealMathUtility.h"
 
 DEFINE_LOG_CATEGORY(LogTeamDeathmatchSpawnerComponent)
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawn Handovers Avoided"), STAT_GDKSpawnHandoversAvoided, STATGROUP_GDKShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawns Outside Authority"), STAT_GDKSpawnsOutsideAuthority, STATGROUP_GDKShooter);
+
 UTeamDeathmatchSpawnerComponent::UTeamDeathmatchSpawnerComponent()
 {	
 	PrimaryComponentTick.bCanEverTick = false;
 	bUseTeamPlayerStarts = true;
 	bShufflePlayerStarts = true;
 	NextPlayerStart = 0;
+	HandoversAvoided = 0;
 }
 
 void UTeamDeathmatchSpawnerComponent::SetTeams(TArray<FGenericTeamId> TeamIds)
@@ -40,7 +50,7 @@ void UTeamDeathmatchSpawnerComponent::SetTeams(TArray<FGenericTeamId> TeamIds)
 		{
 			if (UTeamComponent* TeamComponent = PlayerStart->FindComponentByClass<UTeamComponent>())
 			{
-				TeamPlayerStarts.Add(PlayerStart);
+				TeamPlayerStarts.FindOrAdd(TeamComponent->GetTeam()).Add(PlayerStart);
 			}
 			else
 			{
@@ -53,12 +63,15 @@ void UTeamDeathmatchSpawnerComponent::SetTeams(TArray<FGenericTeamId> TeamIds)
 		}
 	}
 
-	if (bUseTeamPlayerStarts)
+	if (bShufflePlayerStarts)
 	{
-		ShufflePlayerStartArray(TeamPlayerStarts);
-	}
+		for (auto& Entry : TeamPlayerStarts)
+		{
+			ShufflePlayerStartArray(Entry.Value);
+		}
 
-	ShufflePlayerStartArray(PlayerStarts);
+		ShufflePlayerStartArray(PlayerStarts);
+	}
 }
 
 void UTeamDeathmatchSpawnerComponent::RequestSpawn(APlayerController* Controller)
@@ -71,8 +84,17 @@ void UTeamDeathmatchSpawnerComponent::RequestSpawn(APlayerController* Controller
 	}
 	else
 	{
-		// Assign player to smallest team.
-		TeamId = GetSmallestTeam();
+		int32 RestoredTeamId = -1;
+		if (Controller->PlayerState != nullptr && RestoredPlayerTeams.RemoveAndCopyValue(Controller->PlayerState->PlayerId, RestoredTeamId) && TeamAssignments.Contains(RestoredTeamId))
+		{
+			// Player was on a team before the worker restarted.
+			TeamId = RestoredTeamId;
+		}
+		else
+		{
+			// Assign player to smallest team.
+			TeamId = GetSmallestTeam();
+		}
 		SpawnedPlayers.Add(Controller, TeamId);
 		TeamAssignments[TeamId] += 1;
 	}
@@ -96,7 +118,7 @@ void UTeamDeathmatchSpawnerComponent::RequestSpawn(APlayerController* Controller
 	{
 		APawn* NewPawn = nullptr;
 
-		NewPawn = GameMode->SpawnDefaultPawnFor(Controller, PlayerStart);
+		NewPawn = UCharacterPoolComponent::SpawnPawnFor(GameMode, Controller, PlayerStart);
 
 		Controller->Possess(NewPawn);
 
@@ -149,6 +171,24 @@ void UTeamDeathmatchSpawnerComponent::PlayerDisconnected(APlayerController* Cont
 	}
 }
 
+void UTeamDeathmatchSpawnerComponent::GetPlayerTeams(TMap<int32, int32>& OutPlayerTeams) const
+{
+	OutPlayerTeams = RestoredPlayerTeams;
+
+	for (const auto& Entry : SpawnedPlayers)
+	{
+		if (Entry.Key != nullptr && Entry.Key->PlayerState != nullptr)
+		{
+			OutPlayerTeams.Add(Entry.Key->PlayerState->PlayerId, Entry.Value);
+		}
+	}
+}
+
+void UTeamDeathmatchSpawnerComponent::RestorePlayerTeams(const TMap<int32, int32>& PlayerTeams)
+{
+	RestoredPlayerTeams = PlayerTeams;
+}
+
 int32 UTeamDeathmatchSpawnerComponent::GetSmallestTeam()
 {
 	int32 SmallestTeam = -1;
@@ -168,36 +208,77 @@ int32 UTeamDeathmatchSpawnerComponent::GetSmallestTeam()
 
 APlayerStart* UTeamDeathmatchSpawnerComponent::GetNextTeamPlayerStart(FGenericTeamId Team)
 {
-	for (int i = 0; i < TeamPlayerStarts.Num(); i++)
+	if (const TArray<APlayerStart*>* Starts = TeamPlayerStarts.Find(Team))
 	{
-		int index = (i + NextTeamPlayerStart.FindOrAdd(Team, 0)) % TeamPlayerStarts.Num();
-		if (const UTeamComponent* TeamComponent = TeamPlayerStarts[index]->FindComponentByClass<UTeamComponent>())
+		return PickPlayerStart(*Starts, NextTeamPlayerStart.FindOrAdd(Team, 0));
+	}
+	return nullptr;
+}
+
+APlayerStart* UTeamDeathmatchSpawnerComponent::GetNextPlayerStart()
+{
+	return PickPlayerStart(PlayerStarts, NextPlayerStart);
+}
+
+APlayerStart* UTeamDeathmatchSpawnerComponent::PickPlayerStart(const TArray<APlayerStart*>& Starts, int32& NextIndex)
+{
+	if (Starts.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const int32 RoundRobinIndex = NextIndex % Starts.Num();
+	int32 ChosenIndex = RoundRobinIndex;
+
+	if (bPreferLocalPlayerStarts)
+	{
+		bool bFoundLocal = false;
+		for (int32 i = 0; i < Starts.Num(); i++)
 		{
-			if (TeamComponent->GetTeam() == Team)
+			const int32 Index = (RoundRobinIndex + i) % Starts.Num();
+			if (IsPlayerStartLocal(Starts[Index]))
 			{
-				NextTeamPlayerStart[Team] = index + 1;
-				return TeamPlayerStarts[index];
+				ChosenIndex = Index;
+				bFoundLocal = true;
+				break;
 			}
 		}
+
+		if (!bFoundLocal)
+		{
+			INC_DWORD_STAT(STAT_GDKSpawnsOutsideAuthority);
+		}
+		else if (ChosenIndex != RoundRobinIndex)
+		{
+			HandoversAvoided++;
+			INC_DWORD_STAT(STAT_GDKSpawnHandoversAvoided);
+			UE_LOG(LogTeamDeathmatchSpawnerComponent, Verbose, TEXT("Spawning at local start %s instead of %s, %d handovers avoided"), *GetNameSafe(Starts[ChosenIndex]), *GetNameSafe(Starts[RoundRobinIndex]), HandoversAvoided);
+		}
 	}
-	return nullptr;
+
+	NextIndex = ChosenIndex + 1;
+	return Starts[ChosenIndex];
 }
 
-APlayerStart* UTeamDeathmatchSpawnerComponent::GetNextPlayerStart()
+bool UTeamDeathmatchSpawnerComponent::IsPlayerStartLocal(const APlayerStart* PlayerStart) const
 {
-	APlayerStart* PlayerStart = PlayerStarts[NextPlayerStart];
-	NextPlayerStart = (NextPlayerStart + 1) % PlayerStarts.Num();
-	
-	return PlayerStart;
+	const USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(GetWorld()->GetNetDriver());
+	if (SpatialNetDriver == nullptr || SpatialNetDriver->LoadBalanceStrategy == nullptr || !SpatialNetDriver->LoadBalanceStrategy->IsReady())
+	{
+		// Without Unreal load balancing every start is as good as any other.
+		return true;
+	}
+
+	return SpatialNetDriver->LoadBalanceStrategy->ShouldHaveAuthority(*PlayerStart);
 }
 
 
-void UTeamDeathmatchSpawnerComponent::ShufflePlayerStartArray(TArray<APlayerStart*> Array)
+void UTeamDeathmatchSpawnerComponent::ShufflePlayerStartArray(TArray<APlayerStart*>& Array)
 {
 	int32 LastIndex = Array.Num() - 1;
 	for (int32 i = 0; i <= LastIndex; ++i)
 	{
-		int32 Index = FMath::RandRange(i, LastIndex);
+		int32 Index = FGDKRandom::GetStream(EGDKRandomStream::Spawn).RandRange(i, LastIndex);
 		if (i != Index)
 		{
 			Array.Swap(i, Index);
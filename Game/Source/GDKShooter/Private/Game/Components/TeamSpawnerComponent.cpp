@@ -5,6 +5,7 @@
 #include "Characters/Components/MetaDataComponent.h"
 #include "Characters/Components/TeamComponent.h"
 #include "EngineUtils.h"
+#include "Game/Components/CharacterPoolComponent.h"
 #include "Game/Components/PlayerPublisher.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
@@ -90,7 +91,7 @@ void UTeamSpawnerComponent::RequestSpawn(APlayerController* Controller)
 	{
 		APawn* NewPawn = nullptr;
 
-		NewPawn = GameMode->SpawnDefaultPawnFor(Controller, PlayerStart);
+		NewPawn = UCharacterPoolComponent::SpawnPawnFor(GameMode, Controller, PlayerStart);
 
 		Controller->Possess(NewPawn);
 
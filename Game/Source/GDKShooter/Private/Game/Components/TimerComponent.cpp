@@ -2,6 +2,7 @@
 
 #include "Game/Components/TimerComponent.h"
 #include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
 #include "GDKLogging.h"
 #include "Net/UnrealNetwork.h"
 
@@ -14,77 +15,171 @@ UTimerComponent::UTimerComponent()
 void UTimerComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	TimeLeft = DefaultTimerDuration;
-	if (bAutoStart)
+
+	if (GetOwner()->HasAuthority())
 	{
-		StartTimer();
+		TimerState.Duration = DefaultTimerDuration;
+		if (bAutoStart)
+		{
+			StartTimer();
+		}
 	}
 }
 
+void UTimerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(FinishTimerHandle);
+	GetWorld()->GetTimerManager().ClearTimer(DisplayTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UTimerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UTimerComponent, bIsTimerRunning);
-	DOREPLIFETIME(UTimerComponent, TimeLeft);
-	DOREPLIFETIME(UTimerComponent, bHasTimerFinished);
+	DOREPLIFETIME(UTimerComponent, TimerState);
+}
+
+float UTimerComponent::GetServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+int32 UTimerComponent::GetTimer() const
+{
+	if (!TimerState.bIsRunning)
+	{
+		return TimerState.Duration;
+	}
+
+	// Whole seconds, so the time left steps down one second after the timer is started.
+	const int32 Elapsed = FMath::FloorToInt(GetServerTime() - TimerState.StartTime);
+	return FMath::Max(0, TimerState.Duration - Elapsed);
 }
 
 void UTimerComponent::StartTimer()
 {
-	TimeLeft = DefaultTimerDuration;
+	TimerState.Duration = DefaultTimerDuration;
 	ResumeTimer();
 }
 
 void UTimerComponent::ResumeTimer()
 {
-	if (bIsTimerRunning)
+	if (TimerState.bIsRunning)
 	{
 		return;
 	}
 
-	bIsTimerRunning = true;
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UTimerComponent::DecrementTimer, 1.0f, true, 1.0f);
+	TimerState.StartTime = GetServerTime();
+	TimerState.bIsRunning = true;
+	ScheduleFinish();
+	OnRep_TimerState();
 }
 
 void UTimerComponent::SetTimer(int32 NewValue)
 {
-	TimeLeft = NewValue;
-	bHasTimerFinished = false;
+	TimerState.StartTime = GetServerTime();
+	TimerState.Duration = NewValue;
+	TimerState.bHasFinished = false;
+	ScheduleFinish();
+	OnRep_TimerState();
 }
 
 void UTimerComponent::StopTimer()
 {
-	bIsTimerRunning = false;
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+	if (TimerState.bIsRunning)
+	{
+		TimerState.Duration = GetTimer();
+		TimerState.bIsRunning = false;
+	}
+
+	GetWorld()->GetTimerManager().ClearTimer(FinishTimerHandle);
+	OnRep_TimerState();
 }
 
-void UTimerComponent::OnRep_Timer()
+void UTimerComponent::RestoreTimer(int32 NewTimeLeft, bool bRunning, bool bFinished)
 {
-	OnTimer.Broadcast(TimeLeft);
+	TimerState.StartTime = GetServerTime();
+	TimerState.Duration = NewTimeLeft;
+	TimerState.bIsRunning = bRunning && !bFinished;
+	TimerState.bHasFinished = bFinished;
+
+	// The match state is restored alongside, so don't announce a finish that has already been acted on.
+	bHadFinished = bFinished;
+
+	ScheduleFinish();
+	OnRep_TimerState();
 }
 
-void UTimerComponent::OnRep_TimerFinished()
+void UTimerComponent::ScheduleFinish()
 {
-	if (bHasTimerFinished)
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	TimerManager.ClearTimer(FinishTimerHandle);
+
+	if (!TimerState.bIsRunning)
 	{
-		OnTimerFinished.Broadcast();
+		return;
+	}
+
+	const float Delay = TimerState.StartTime + TimerState.Duration - GetServerTime();
+	if (Delay > 0.f)
+	{
+		TimerManager.SetTimer(FinishTimerHandle, this, &UTimerComponent::FinishTimer, Delay, false);
+	}
+	else
+	{
+		TimerManager.SetTimerForNextTick(this, &UTimerComponent::FinishTimer);
 	}
 }
 
-void UTimerComponent::DecrementTimer()
+void UTimerComponent::FinishTimer()
 {
-	if (GetOwnerRole() != ROLE_Authority)
+	if (GetOwnerRole() != ROLE_Authority || !TimerState.bIsRunning)
 	{
 		return;
 	}
 
-	TimeLeft--;
+	TimerState.Duration = 0;
+	TimerState.bIsRunning = false;
+	TimerState.bHasFinished = true;
+	OnRep_TimerState();
+}
+
+void UTimerComponent::UpdateDisplayedTime()
+{
+	const int32 TimeLeft = GetTimer();
+	if (TimeLeft != LastBroadcastTime)
+	{
+		LastBroadcastTime = TimeLeft;
+		OnTimer.Broadcast(TimeLeft);
+	}
+}
+
+void UTimerComponent::OnRep_TimerState()
+{
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+		if (TimerState.bIsRunning)
+		{
+			// Wake up just after each whole second boundary, when the time left changes.
+			const float Elapsed = GetServerTime() - TimerState.StartTime;
+			const float FirstDelay = FMath::Max(1.f - FMath::Frac(Elapsed), KINDA_SMALL_NUMBER);
+			TimerManager.SetTimer(DisplayTimerHandle, this, &UTimerComponent::UpdateDisplayedTime, 1.f, true, FirstDelay);
+		}
+		else
+		{
+			TimerManager.ClearTimer(DisplayTimerHandle);
+		}
+
+		UpdateDisplayedTime();
+	}
 
-	if (TimeLeft <= 0)
+	if (TimerState.bHasFinished && !bHadFinished)
 	{
-		bHasTimerFinished = true;
-		StopTimer();
 		OnTimerFinished.Broadcast();
 	}
+	bHadFinished = TimerState.bHasFinished;
 }
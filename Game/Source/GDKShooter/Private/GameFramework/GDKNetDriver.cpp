@@ -0,0 +1,65 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "GameFramework/GDKNetDriver.h"
+#include "UObject/CoreNet.h"
+#include "UObject/UnrealType.h"
+
+void UGDKNetDriver::ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject)
+{
+	if (bCountRpcs && Function != nullptr)
+	{
+		RpcCounts.FindOrAdd(Function->GetFName())++;
+	}
+
+	if (bMeasureRpcBytes && Function != nullptr)
+	{
+		MeasuredRpcBytes += GetSerializedParameterBytes(Function, Parameters);
+	}
+
+	Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+}
+
+void UGDKNetDriver::SetCountRpcs(bool bEnabled)
+{
+	bCountRpcs = bEnabled;
+	if (!bCountRpcs)
+	{
+		RpcCounts.Empty();
+	}
+}
+
+void UGDKNetDriver::ConsumeRpcCounts(TMap<FName, int32>& OutCounts)
+{
+	for (const TPair<FName, int32>& RpcCount : RpcCounts)
+	{
+		OutCounts.FindOrAdd(RpcCount.Key) += RpcCount.Value;
+	}
+	RpcCounts.Reset();
+}
+
+void UGDKNetDriver::BeginMeasuringRpcBytes()
+{
+	bMeasureRpcBytes = true;
+	MeasuredRpcBytes = 0;
+}
+
+int32 UGDKNetDriver::EndMeasuringRpcBytes()
+{
+	bMeasureRpcBytes = false;
+	return MeasuredRpcBytes;
+}
+
+int32 UGDKNetDriver::GetSerializedParameterBytes(UFunction* Function, void* Parameters)
+{
+	// Each parameter the way it is written into the RPC payload, quantized vectors and object references included.
+	FNetBitWriter Writer(PackageMap, 0);
+	for (TFieldIterator<UProperty> It(Function); It && (It->PropertyFlags & (CPF_Parm | CPF_ReturnParm)) == CPF_Parm; ++It)
+	{
+		for (int32 i = 0; i < It->ArrayDim; i++)
+		{
+			It->NetSerializeItem(Writer, PackageMap, It->ContainerPtrToValuePtr<void>(Parameters, i));
+		}
+	}
+
+	return (int32)((Writer.GetNumBits() + 7) >> 3);
+}
@@ -0,0 +1,34 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Metrics/GDKFunctionTimings.h"
+
+TMap<FName, FGDKFunctionTimings::FTiming> FGDKFunctionTimings::Timings;
+bool FGDKFunctionTimings::bIsEnabled = false;
+
+void FGDKFunctionTimings::Add(FName Name, uint64 Cycles)
+{
+	check(IsInGameThread());
+
+	FTiming& Timing = Timings.FindOrAdd(Name);
+	Timing.Calls++;
+	Timing.Cycles += Cycles;
+}
+
+void FGDKFunctionTimings::Reset()
+{
+	Timings.Reset();
+}
+
+FString FGDKFunctionTimings::ToCsv()
+{
+	Timings.ValueSort([](const FTiming& A, const FTiming& B) { return A.Cycles > B.Cycles; });
+
+	FString Csv = TEXT("Name,Calls,TotalMs,MsPerCall") LINE_TERMINATOR;
+	for (const TPair<FName, FTiming>& Timing : Timings)
+	{
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Timing.Value.Cycles);
+		Csv += FString::Printf(TEXT("%s,%lld,%.3f,%.6f") LINE_TERMINATOR, *Timing.Key.ToString(), Timing.Value.Calls, TotalMs, TotalMs / Timing.Value.Calls);
+	}
+
+	return Csv;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Metrics/GDKHistogram.h"
+
+FGDKHistogram::FGDKHistogram(double InMinValue, double InGrowth, int32 InNumBuckets)
+	: MinValue(FMath::Max(InMinValue, SMALL_NUMBER))
+	, Growth(FMath::Max(InGrowth, 1.01))
+{
+	Buckets.SetNumZeroed(FMath::Max(InNumBuckets, 2));
+	Reset();
+}
+
+void FGDKHistogram::Add(double Value)
+{
+	Buckets[GetBucketIndex(Value)]++;
+
+	Min = Count == 0 ? Value : FMath::Min(Min, Value);
+	Max = Count == 0 ? Value : FMath::Max(Max, Value);
+	Sum += Value;
+	Count++;
+}
+
+void FGDKHistogram::Reset()
+{
+	for (int64& Bucket : Buckets)
+	{
+		Bucket = 0;
+	}
+	Count = 0;
+	Sum = 0.0;
+	Min = 0.0;
+	Max = 0.0;
+}
+
+int32 FGDKHistogram::GetBucketIndex(double Value) const
+{
+	if (Value <= MinValue)
+	{
+		return 0;
+	}
+
+	const int32 Index = 1 + FMath::FloorToInt(FMath::Loge(Value / MinValue) / FMath::Loge(Growth));
+	return FMath::Clamp(Index, 0, Buckets.Num() - 1);
+}
+
+double FGDKHistogram::GetBucketUpperBound(int32 Index) const
+{
+	return MinValue * FMath::Pow(Growth, Index);
+}
+
+double FGDKHistogram::GetPercentile(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const int64 Target = FMath::Max<int64>(1, FMath::CeilToInt(Count * FMath::Clamp(Percentile, 0.0, 100.0) / 100.0));
+	int64 Seen = 0;
+	for (int32 i = 0; i < Buckets.Num(); i++)
+	{
+		Seen += Buckets[i];
+		if (Seen >= Target)
+		{
+			return FMath::Min(GetBucketUpperBound(i), Max);
+		}
+	}
+	return Max;
+}
+
+FString FGDKHistogram::ToString() const
+{
+	return FString::Printf(TEXT("n=%lld mean=%.2f p50=%.2f p90=%.2f p99=%.2f max=%.2f"),
+		Count, GetMean(), GetPercentile(50), GetPercentile(90), GetPercentile(99), GetMax());
+}
+
+FString FGDKHistogram::GetCsvHeader()
+{
+	return TEXT("Name,Count,Mean,Min,P50,P90,P99,Max");
+}
+
+FString FGDKHistogram::ToCsvRow(const FString& Name) const
+{
+	return FString::Printf(TEXT("%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f"),
+		*Name, Count, GetMean(), GetMin(), GetPercentile(50), GetPercentile(90), GetPercentile(99), GetMax());
+}
@@ -0,0 +1,241 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Phases/PhaseManagerComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GDKLogging.h"
+#include "GDKShooterFunctionLibrary.h"
+#include "Phases/IPhaseActivated.h"
+#include "Net/UnrealNetwork.h"
+
+UPhaseManagerComponent::UPhaseManagerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UPhaseManagerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UPhaseManagerComponent, Schedule);
+}
+
+UPhaseManagerComponent* UPhaseManagerComponent::Get(const UObject* WorldContextObject)
+{
+	return UGDKShooterFunctionLibrary::GetGameStateComponent<UPhaseManagerComponent>(WorldContextObject);
+}
+
+void UPhaseManagerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!GetOwner()->HasAuthority() || !bStartWithMatch)
+	{
+		return;
+	}
+
+	if (UMatchStateComponent* MatchState = GetOwner()->FindComponentByClass<UMatchStateComponent>())
+	{
+		MatchState->MatchEvent.AddDynamic(this, &UPhaseManagerComponent::OnMatchStateChanged);
+	}
+}
+
+void UPhaseManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(PhaseTimerHandle);
+	Listeners.Empty();
+	Characters.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPhaseManagerComponent::OnMatchStateChanged(EMatchState NewState)
+{
+	if (NewState == EMatchState::InGame && !HasStarted())
+	{
+		StartPhases();
+	}
+}
+
+void UPhaseManagerComponent::RegisterPhaseListener(UObject* Listener, int32 Phase)
+{
+	if (Listener == nullptr || !Listener->GetClass()->ImplementsInterface(UPhaseActivated::StaticClass()))
+	{
+		return;
+	}
+
+	UPhaseManagerComponent* Manager = Get(Listener);
+	if (Manager == nullptr)
+	{
+		// Only maps driven by the Blueprint PhaseBasedMapComponent still call their listeners, by iterating the world.
+		UE_LOG(LogGDK, Warning, TEXT("%s registered for phase %d but the GameState has no UPhaseManagerComponent, so it will only be called by a Blueprint PhaseBasedMapComponent"),
+			*Listener->GetName(), Phase);
+		return;
+	}
+
+	Manager->Listeners.FindOrAdd(Phase).AddUnique(Listener);
+
+	// Already past it, e.g. actors streamed in or spawned late.
+	if (Manager->CurrentPhase >= Phase)
+	{
+		IPhaseActivated::Execute_SnapToPhase(Listener, Manager->CurrentPhase);
+	}
+}
+
+void UPhaseManagerComponent::UnregisterPhaseListener(UObject* Listener)
+{
+	UPhaseManagerComponent* Manager = Get(Listener);
+	if (Manager == nullptr)
+	{
+		return;
+	}
+
+	for (TPair<int32, TArray<TWeakObjectPtr<UObject>>>& Bucket : Manager->Listeners)
+	{
+		Bucket.Value.RemoveSingleSwap(Listener);
+	}
+}
+
+void UPhaseManagerComponent::RegisterCharacter(AGDKCharacter* Character)
+{
+	Characters.AddUnique(Character);
+}
+
+void UPhaseManagerComponent::UnregisterCharacter(AGDKCharacter* Character)
+{
+	Characters.RemoveSwap(Character);
+}
+
+void UPhaseManagerComponent::StartPhases()
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	Schedule.Phases = DefaultPhases;
+	Schedule.StartTime = GetServerTime();
+	OnRep_Schedule();
+}
+
+float UPhaseManagerComponent::GetServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+float UPhaseManagerComponent::GetPhaseEndTime(int32 Phase) const
+{
+	float EndTime = Schedule.StartTime;
+	for (int32 i = 0; i <= Phase && i < Schedule.Phases.Num(); i++)
+	{
+		if (Schedule.Phases[i].Duration <= 0.f)
+		{
+			return TNumericLimits<float>::Max();
+		}
+		EndTime += Schedule.Phases[i].Duration;
+	}
+	return EndTime;
+}
+
+float UPhaseManagerComponent::GetPhaseTimeRemaining() const
+{
+	if (!Schedule.Phases.IsValidIndex(CurrentPhase) || Schedule.Phases[CurrentPhase].Duration <= 0.f)
+	{
+		return 0.f;
+	}
+
+	return FMath::Max(0.f, GetPhaseEndTime(CurrentPhase) - GetServerTime());
+}
+
+bool UPhaseManagerComponent::GetCurrentPhaseEntry(FPhaseEntry& OutEntry) const
+{
+	if (!Schedule.Phases.IsValidIndex(CurrentPhase))
+	{
+		return false;
+	}
+
+	OutEntry = Schedule.Phases[CurrentPhase];
+	return true;
+}
+
+void UPhaseManagerComponent::OnRep_Schedule()
+{
+	UpdatePhase();
+}
+
+void UPhaseManagerComponent::UpdatePhase()
+{
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	TimerManager.ClearTimer(PhaseTimerHandle);
+
+	if (!HasStarted())
+	{
+		return;
+	}
+
+	const float Now = GetServerTime();
+	int32 NewPhase = 0;
+	while (NewPhase < Schedule.Phases.Num() && GetPhaseEndTime(NewPhase) <= Now)
+	{
+		NewPhase++;
+	}
+
+	if (NewPhase != CurrentPhase)
+	{
+		if (CurrentPhase == INDEX_NONE && NewPhase > 0)
+		{
+			// Joined part way through, so catch up without playing every phase's transition.
+			CurrentPhase = NewPhase;
+			for (int32 Phase = 0; Phase <= NewPhase; Phase++)
+			{
+				NotifyListeners(Phase, true);
+			}
+		}
+		else
+		{
+			while (CurrentPhase < NewPhase)
+			{
+				CurrentPhase++;
+				NotifyListeners(CurrentPhase, false);
+			}
+		}
+
+		PhaseChanged.Broadcast(CurrentPhase);
+	}
+
+	const float EndTime = GetPhaseEndTime(CurrentPhase);
+	if (CurrentPhase < Schedule.Phases.Num() && EndTime < TNumericLimits<float>::Max())
+	{
+		TimerManager.SetTimer(PhaseTimerHandle, this, &UPhaseManagerComponent::UpdatePhase, FMath::Max(EndTime - Now, KINDA_SMALL_NUMBER), false);
+	}
+}
+
+void UPhaseManagerComponent::NotifyListeners(int32 Phase, bool bSnap)
+{
+	TArray<TWeakObjectPtr<UObject>>* Bucket = Listeners.Find(Phase);
+	if (Bucket == nullptr)
+	{
+		return;
+	}
+
+	Bucket->RemoveAllSwap([](const TWeakObjectPtr<UObject>& Listener) { return !Listener.IsValid(); });
+
+	// Listeners may unregister or register others when called.
+	const TArray<TWeakObjectPtr<UObject>> ToNotify = *Bucket;
+	for (const TWeakObjectPtr<UObject>& Listener : ToNotify)
+	{
+		if (UObject* Object = Listener.Get())
+		{
+			if (bSnap)
+			{
+				IPhaseActivated::Execute_SnapToPhase(Object, CurrentPhase);
+			}
+			else
+			{
+				IPhaseActivated::Execute_ProgressToPhase(Object, Phase);
+			}
+		}
+	}
+}
@@ -0,0 +1,255 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Phases/PhasedSafeZone.h"
+#include "Characters/GDKCharacter.h"
+#include "Characters/Components/HealthComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "Game/Components/NPCSignificanceComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GDKStats.h"
+#include "Phases/PhaseManagerComponent.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Safe Zone Damage"), STAT_GDKSafeZoneDamage, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawns Outside Safe Zone"), STAT_GDKPawnsOutsideSafeZone, STATGROUP_GDKShooter);
+
+namespace
+{
+	// Offset is from the centre of the safe area. Positive outside.
+	FORCEINLINE float SignedDistance(ESafeZoneShape Shape, float OffsetX, float OffsetY, const FVector2D& Extent)
+	{
+		if (Shape == ESafeZoneShape::Circle)
+		{
+			return FMath::Sqrt(OffsetX * OffsetX + OffsetY * OffsetY) - Extent.X;
+		}
+
+		const float QX = FMath::Abs(OffsetX) - Extent.X;
+		const float QY = FMath::Abs(OffsetY) - Extent.Y;
+		const float OutsideX = FMath::Max(QX, 0.f);
+		const float OutsideY = FMath::Max(QY, 0.f);
+		return FMath::Sqrt(OutsideX * OutsideX + OutsideY * OutsideY) + FMath::Min(FMath::Max(QX, QY), 0.f);
+	}
+}
+
+APhasedSafeZone::APhasedSafeZone()
+	: Shape(ESafeZoneShape::Circle)
+	, InitialExtent(50000.f, 50000.f)
+	, DamageInterval(1.f)
+	, DamageType(UDamageType::StaticClass())
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	// Every machine works out the zone itself, so there is nothing to send after the initial state.
+	NetUpdateFrequency = 1.f;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	ZoneMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ZoneMesh"));
+	ZoneMesh->SetupAttachment(RootComponent);
+	ZoneMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	ZoneMesh->SetGenerateOverlapEvents(false);
+	ZoneMesh->SetHiddenInGame(true);
+}
+
+void APhasedSafeZone::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Every server damages the characters it has authority over.
+	if (GetNetMode() != NM_Client && DamageInterval > 0.f)
+	{
+		GetWorldTimerManager().SetTimer(DamageTimerHandle, this, &APhasedSafeZone::ApplyZoneDamage, DamageInterval, true);
+	}
+
+	SetActorTickEnabled(GetNetMode() != NM_DedicatedServer);
+
+	for (const FSafeZonePhase& Phase : Phases)
+	{
+		UPhaseManagerComponent::RegisterPhaseListener(this, Phase.StartsInPhase);
+	}
+}
+
+void APhasedSafeZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(DamageTimerHandle);
+	UPhaseManagerComponent::UnregisterPhaseListener(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APhasedSafeZone::SnapToPhase_Implementation(int32 Phase)
+{
+	StartZonePhaseFor(Phase, true);
+}
+
+void APhasedSafeZone::ProgressToPhase_Implementation(int32 Phase)
+{
+	StartZonePhaseFor(Phase, false);
+}
+
+void APhasedSafeZone::StartZonePhaseFor(int32 Phase, bool bSnap)
+{
+	int32 PhaseIndex = INDEX_NONE;
+	for (int32 i = 0; i < Phases.Num() && Phases[i].StartsInPhase <= Phase; i++)
+	{
+		PhaseIndex = i;
+	}
+
+	if (PhaseIndex == INDEX_NONE || PhaseIndex == Progress.PhaseIndex)
+	{
+		return;
+	}
+
+	Progress.PhaseIndex = PhaseIndex;
+
+	const UPhaseManagerComponent* PhaseManager = UPhaseManagerComponent::Get(this);
+	if (PhaseManager != nullptr && PhaseManager->HasStarted())
+	{
+		// The real start of the map phase, so late joiners and every worker see the same shrink.
+		Progress.StartTime = PhaseManager->GetPhaseStartTime(Phases[PhaseIndex].StartsInPhase);
+	}
+	else
+	{
+		Progress.StartTime = GetServerTime() - (bSnap ? Phases[PhaseIndex].ShrinkDuration : 0.f);
+	}
+
+	OnZonePhaseStarted(PhaseIndex);
+}
+
+float APhasedSafeZone::GetServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+bool APhasedSafeZone::GetSafeArea(FVector2D& OutCenter, FVector2D& OutExtent) const
+{
+	return GetSafeAreaAt(GetServerTime(), OutCenter, OutExtent);
+}
+
+bool APhasedSafeZone::GetSafeAreaAt(float Time, FVector2D& OutCenter, FVector2D& OutExtent) const
+{
+	if (!Phases.IsValidIndex(Progress.PhaseIndex))
+	{
+		return false;
+	}
+
+	const FSafeZonePhase& Phase = Phases[Progress.PhaseIndex];
+	const FVector2D FromCenter = Progress.PhaseIndex > 0 ? Phases[Progress.PhaseIndex - 1].Center : FVector2D(GetActorLocation());
+	const FVector2D FromExtent = Progress.PhaseIndex > 0 ? Phases[Progress.PhaseIndex - 1].Extent : InitialExtent;
+
+	const float Alpha = Phase.ShrinkDuration > 0.f ? FMath::Clamp((Time - Progress.StartTime) / Phase.ShrinkDuration, 0.f, 1.f) : 1.f;
+	OutCenter = FMath::Lerp(FromCenter, Phase.Center, Alpha);
+	OutExtent = FMath::Lerp(FromExtent, Phase.Extent, Alpha);
+	return true;
+}
+
+float APhasedSafeZone::GetSignedDistance(const FVector& Location) const
+{
+	FVector2D Center;
+	FVector2D Extent;
+	if (!GetSafeArea(Center, Extent))
+	{
+		return 0.f;
+	}
+
+	return SignedDistance(Shape, Location.X - Center.X, Location.Y - Center.Y, Extent);
+}
+
+void APhasedSafeZone::ApplyZoneDamage()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKSafeZoneDamage);
+
+	const UPhaseManagerComponent* PhaseManager = UPhaseManagerComponent::Get(this);
+	FVector2D Center;
+	FVector2D Extent;
+	if (PhaseManager == nullptr || !GetSafeArea(Center, Extent))
+	{
+		return;
+	}
+
+	const float Damage = Phases[Progress.PhaseIndex].DamagePerSecond * DamageInterval;
+	if (Damage <= 0.f)
+	{
+		return;
+	}
+
+	// Gather positions relative to the centre into flat arrays, so the distance pass below is a tight loop.
+	CharacterScratch.Reset();
+	XScratch.Reset();
+	YScratch.Reset();
+	for (AGDKCharacter* Character : PhaseManager->GetCharacters())
+	{
+		// Hidden characters are parked in the character pool.
+		if (Character == nullptr || !Character->HasAuthority() || Character->IsHidden() || !Character->CanBeDamaged()
+			|| Character->GetHealthComponent()->GetCurrentHealth() <= 0.f)
+		{
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		CharacterScratch.Add(Character);
+		XScratch.Add(Location.X - Center.X);
+		YScratch.Add(Location.Y - Center.Y);
+	}
+
+	const int32 NumCharacters = CharacterScratch.Num();
+	DistanceScratch.SetNumUninitialized(NumCharacters, false);
+
+	const float* RESTRICT Xs = XScratch.GetData();
+	const float* RESTRICT Ys = YScratch.GetData();
+	float* RESTRICT Distances = DistanceScratch.GetData();
+	if (Shape == ESafeZoneShape::Circle)
+	{
+		for (int32 i = 0; i < NumCharacters; i++)
+		{
+			Distances[i] = SignedDistance(ESafeZoneShape::Circle, Xs[i], Ys[i], Extent);
+		}
+	}
+	else
+	{
+		for (int32 i = 0; i < NumCharacters; i++)
+		{
+			Distances[i] = SignedDistance(ESafeZoneShape::Box, Xs[i], Ys[i], Extent);
+		}
+	}
+
+	// Every character here is local and the zone has no instigator, so skip the actor's TakeDamage and its cross
+	// server RPC and go straight to the health component.
+	UNPCSignificanceComponent* NPCSignificance = UNPCSignificanceComponent::Get(this);
+	const FDamageEvent DamageEvent(DamageType);
+	for (int32 i = 0; i < NumCharacters; i++)
+	{
+		if (Distances[i] > 0.f)
+		{
+			INC_DWORD_STAT(STAT_GDKPawnsOutsideSafeZone);
+			CharacterScratch[i]->GetHealthComponent()->TakeDamage(Damage, DamageEvent, nullptr, this);
+			if (NPCSignificance != nullptr)
+			{
+				NPCSignificance->NotifyDamaged(CharacterScratch[i]);
+			}
+		}
+	}
+}
+
+void APhasedSafeZone::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	FVector2D Center;
+	FVector2D Extent;
+	if (!GetSafeArea(Center, Extent))
+	{
+		ZoneMesh->SetHiddenInGame(true);
+		return;
+	}
+
+	const FVector2D Size = Shape == ESafeZoneShape::Circle ? FVector2D(Extent.X, Extent.X) * 2.f : Extent * 2.f;
+	ZoneMesh->SetHiddenInGame(false);
+	ZoneMesh->SetWorldLocation(FVector(Center, ZoneMesh->GetComponentLocation().Z));
+	ZoneMesh->SetWorldScale3D(FVector(Size / 100.f, ZoneMesh->GetComponentScale().Z));
+}
@@ -0,0 +1,47 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "CoreMinimal.h"
+#include "Game/Components/PlayerNameTableComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FPlayerNameEntry MakeNameEntry(int32 PlayerId, const FString& PlayerName)
+	{
+		FPlayerNameEntry Entry;
+		Entry.PlayerId = PlayerId;
+		Entry.PlayerName = PlayerName;
+		return Entry;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerNameTableLookupTest, "GDKShooter.Scores.PlayerNameTable", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlayerNameTableLookupTest::RunTest(const FString& Parameters)
+{
+	UPlayerNameTableComponent* NameTable = NewObject<UPlayerNameTableComponent>();
+
+	TestNull(TEXT("Empty table has no names"), NameTable->FindPlayerName(1));
+	TestEqual(TEXT("Unknown player's name is empty"), NameTable->GetPlayerName(1), FString());
+
+	NameTable->RestoreEntries({ MakeNameEntry(7, TEXT("Alpha")), MakeNameEntry(3, TEXT("Bravo")), MakeNameEntry(12, TEXT("Charlie")) });
+
+	TestEqual(TEXT("Name of player 7"), NameTable->GetPlayerName(7), FString(TEXT("Alpha")));
+	TestEqual(TEXT("Name of player 3"), NameTable->GetPlayerName(3), FString(TEXT("Bravo")));
+	TestEqual(TEXT("Name of player 12"), NameTable->GetPlayerName(12), FString(TEXT("Charlie")));
+	TestNull(TEXT("Player 4 isn't in the table"), NameTable->FindPlayerName(4));
+	TestEqual(TEXT("Number of entries"), NameTable->GetEntries().Num(), 3);
+
+	// Restoring replaces the table, so the index must not point at old entries.
+	NameTable->RestoreEntries({ MakeNameEntry(12, TEXT("Delta")) });
+
+	TestEqual(TEXT("Name of player 12 after restoring"), NameTable->GetPlayerName(12), FString(TEXT("Delta")));
+	TestNull(TEXT("Player 7 is gone after restoring"), NameTable->FindPlayerName(7));
+	TestNull(TEXT("Player 3 is gone after restoring"), NameTable->FindPlayerName(3));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
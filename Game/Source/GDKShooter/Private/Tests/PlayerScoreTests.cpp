@@ -0,0 +1,53 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "CoreMinimal.h"
+#include "Game/Components/DeathmatchScoreComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FPlayerScore MakeSortScore(int32 PlayerId, int32 Kills, int32 Deaths)
+	{
+		FPlayerScore Score;
+		Score.PlayerId = PlayerId;
+		Score.Kills = Kills;
+		Score.Deaths = Deaths;
+		return Score;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSortPlayerScoresTest, "GDKShooter.Scores.SortPlayerScores", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSortPlayerScoresTest::RunTest(const FString& Parameters)
+{
+	TArray<FPlayerScore> Scores;
+	Scores.Add(MakeSortScore(1, 2, 5));
+	Scores.Add(MakeSortScore(2, 7, 3));
+	Scores.Add(MakeSortScore(3, 2, 1));
+	Scores.Add(MakeSortScore(4, 0, 0));
+	Scores.Add(MakeSortScore(5, 7, 1));
+
+	UDeathmatchScoreComponent::SortPlayerScores(Scores);
+
+	// Most kills first, fewest deaths breaking ties.
+	const TArray<int32> ExpectedOrder = { 5, 2, 3, 1, 4 };
+	if (!TestEqual(TEXT("Number of scores"), Scores.Num(), ExpectedOrder.Num()))
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < Scores.Num(); i++)
+	{
+		TestEqual(*FString::Printf(TEXT("Player at %d"), i), Scores[i].PlayerId, ExpectedOrder[i]);
+	}
+
+	TArray<FPlayerScore> Empty;
+	UDeathmatchScoreComponent::SortPlayerScores(Empty);
+	TestEqual(TEXT("Empty scores stay empty"), Empty.Num(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,81 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "UI/ScoreboardViewModel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FPlayerScore MakeScoreboardScore(int32 PlayerId, int32 Kills, int32 Deaths)
+	{
+		FPlayerScore Score;
+		Score.PlayerId = PlayerId;
+		Score.Kills = Kills;
+		Score.Deaths = Deaths;
+		return Score;
+	}
+
+	// Checks the rows list exactly these players in this order, and that every row knows its own index.
+	void TestScoreboardRows(FAutomationTestBase& Test, const FString& What, const UScoreboardViewModel* ViewModel, const TArray<int32>& ExpectedPlayerIds)
+	{
+		const TArray<UScoreboardEntry*>& Rows = ViewModel->GetRows();
+		if (!Test.TestEqual(*(What + TEXT(": number of rows")), Rows.Num(), ExpectedPlayerIds.Num()))
+		{
+			return;
+		}
+
+		for (int32 i = 0; i < Rows.Num(); i++)
+		{
+			Test.TestEqual(*FString::Printf(TEXT("%s: player at %d"), *What, i), Rows[i]->Score.PlayerId, ExpectedPlayerIds[i]);
+			Test.TestEqual(*FString::Printf(TEXT("%s: index of row %d"), *What, i), Rows[i]->Index, i);
+			Test.TestEqual(*FString::Printf(TEXT("%s: row %d found by player id"), *What, i), ViewModel->FindRow(ExpectedPlayerIds[i]), Rows[i]);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScoreboardDiffTest, "GDKShooter.Scores.ScoreboardDiff", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FScoreboardDiffTest::RunTest(const FString& Parameters)
+{
+	UScoreboardViewModel* ViewModel = NewObject<UScoreboardViewModel>();
+
+	ViewModel->ApplyPlayerScores({ MakeScoreboardScore(1, 5, 0), MakeScoreboardScore(2, 3, 1), MakeScoreboardScore(3, 1, 2) });
+	TestScoreboardRows(*this, TEXT("Initial scores"), ViewModel, { 1, 2, 3 });
+
+	UScoreboardEntry* const FirstRow = ViewModel->FindRow(1);
+	UScoreboardEntry* const ThirdRow = ViewModel->FindRow(3);
+
+	// Player 3 overtakes everyone, player 1 keeps their entry while moving down.
+	ViewModel->ApplyPlayerScores({ MakeScoreboardScore(3, 9, 2), MakeScoreboardScore(1, 5, 0), MakeScoreboardScore(2, 3, 1) });
+	TestScoreboardRows(*this, TEXT("After a move"), ViewModel, { 3, 1, 2 });
+	TestEqual(TEXT("Moved player keeps their entry"), ViewModel->FindRow(3), ThirdRow);
+	TestEqual(TEXT("Passed player keeps their entry"), ViewModel->FindRow(1), FirstRow);
+	TestEqual(TEXT("Moved player's kills are updated"), ThirdRow->Score.Kills, 9);
+
+	// Player 2 leaves and player 4 joins.
+	ViewModel->ApplyPlayerScores({ MakeScoreboardScore(3, 9, 2), MakeScoreboardScore(4, 6, 0), MakeScoreboardScore(1, 5, 0) });
+	TestScoreboardRows(*this, TEXT("After a leave and a join"), ViewModel, { 3, 4, 1 });
+	TestNull(TEXT("Player 2 is no longer listed"), ViewModel->FindRow(2));
+
+	// Team scores list players team by team, in the order given.
+	FTeamScore Red;
+	Red.TeamName = TEXT("Red");
+	Red.PlayerScores = { MakeScoreboardScore(1, 5, 0) };
+	FTeamScore Blue;
+	Blue.TeamName = TEXT("Blue");
+	Blue.PlayerScores = { MakeScoreboardScore(3, 9, 2), MakeScoreboardScore(4, 6, 0) };
+
+	ViewModel->ApplyTeamScores({ Red, Blue });
+	TestScoreboardRows(*this, TEXT("Team scores"), ViewModel, { 1, 3, 4 });
+	TestEqual(TEXT("Player 1's team"), ViewModel->FindRow(1)->TeamName, FName(TEXT("Red")));
+	TestEqual(TEXT("Player 4's team"), ViewModel->FindRow(4)->TeamName, FName(TEXT("Blue")));
+
+	ViewModel->ApplyPlayerScores({});
+	TestScoreboardRows(*this, TEXT("No scores"), ViewModel, {});
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -7,7 +7,9 @@
 #include "Game/Components/LobbyTimerComponent.h"
 #include "Game/Components/MatchTimerComponent.h"
 #include "Game/Components/PlayerCountingComponent.h"
+#include "Components/ListView.h"
 #include "GameFramework/GameStateBase.h"
+#include "UI/ScoreboardViewModel.h"
 #include "Weapons/InstantWeapon.h"
 
 #include "EngineClasses/SpatialGameInstance.h"
@@ -45,16 +47,19 @@ void UGDKWidget::NativeConstruct()
 		ControllerEvents->DeathDetailsEvent.AddDynamic(this, &UGDKWidget::OnDeath);
 	}
 
+	Scoreboard = NewObject<UScoreboardViewModel>(this);
+	Scoreboard->RowsChanged.AddDynamic(this, &UGDKWidget::OnScoreboardRowsChanged);
+
 	if (UDeathmatchScoreComponent* Deathmatch = Cast<UDeathmatchScoreComponent>(GetWorld()->GetGameState()->GetComponentByClass(UDeathmatchScoreComponent::StaticClass())))
 	{
-		Deathmatch->ScoreEvent.AddDynamic(this, &UGDKWidget::OnPlayerScoresUpdated);
-		OnPlayerScoresUpdated(Deathmatch->PlayerScores());
+		Deathmatch->ScoreEvent.AddDynamic(this, &UGDKWidget::OnPlayerScoresChanged);
+		OnPlayerScoresChanged(Deathmatch->PlayerScores());
 	}
 
 	if (UTeamDeathmatchScoreComponent* TeamDeathmatch = GetWorld()->GetGameState()->FindComponentByClass<UTeamDeathmatchScoreComponent>())
 	{
-		TeamDeathmatch->ScoreEvent.AddDynamic(this, &UGDKWidget::OnTeamScoresUpdated);
-		OnTeamScoresUpdated(TeamDeathmatch->TeamScores());
+		TeamDeathmatch->ScoreEvent.AddDynamic(this, &UGDKWidget::OnTeamScoresChanged);
+		OnTeamScoresChanged(TeamDeathmatch->TeamScores());
 	}
 
 	if (UPlayerCountingComponent* PlayerCounter = Cast<UPlayerCountingComponent>(GetWorld()->GetGameState()->GetComponentByClass(UPlayerCountingComponent::StaticClass())))
@@ -108,6 +113,36 @@ void UGDKWidget::OnPawn(APawn* InPawn)
 	}
 }
 
+void UGDKWidget::OnPlayerScoresChanged(const TArray<FPlayerScore>& Scores)
+{
+	Scoreboard->ApplyPlayerScores(Scores);
+
+	// Widgets without a list still rebuild their scoreboard from the full array.
+	if (ScoreboardList == nullptr)
+	{
+		OnPlayerScoresUpdated(Scores);
+	}
+}
+
+void UGDKWidget::OnTeamScoresChanged(const TArray<FTeamScore>& Scores)
+{
+	Scoreboard->ApplyTeamScores(Scores);
+
+	if (ScoreboardList == nullptr)
+	{
+		OnTeamScoresUpdated(Scores);
+	}
+}
+
+void UGDKWidget::OnScoreboardRowsChanged()
+{
+	// Score changes alone are picked up by the visible rows, so the list only needs the new order.
+	if (ScoreboardList != nullptr)
+	{
+		ScoreboardList->SetListItems(Scoreboard->GetRows());
+	}
+}
+
 // Function to call to ClientTravel to the TargetMap
 void UGDKWidget::LeaveGame(const FString& TargetMap)
 {
@@ -0,0 +1,37 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "UI/ScoreboardRowWidget.h"
+#include "UI/ScoreboardViewModel.h"
+
+void UScoreboardRowWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+	if (ShownEntry != nullptr)
+	{
+		ShownEntry->OnChanged.RemoveDynamic(this, &UScoreboardRowWidget::OnEntryChanged);
+	}
+
+	ShownEntry = Cast<UScoreboardEntry>(ListItemObject);
+	if (ShownEntry != nullptr)
+	{
+		ShownEntry->OnChanged.AddUniqueDynamic(this, &UScoreboardRowWidget::OnEntryChanged);
+		OnRowUpdated(ShownEntry);
+	}
+}
+
+void UScoreboardRowWidget::NativeOnEntryReleased()
+{
+	if (ShownEntry != nullptr)
+	{
+		ShownEntry->OnChanged.RemoveDynamic(this, &UScoreboardRowWidget::OnEntryChanged);
+		ShownEntry = nullptr;
+	}
+
+	IUserObjectListEntry::NativeOnEntryReleased();
+}
+
+void UScoreboardRowWidget::OnEntryChanged(UScoreboardEntry* Entry)
+{
+	OnRowUpdated(Entry);
+}
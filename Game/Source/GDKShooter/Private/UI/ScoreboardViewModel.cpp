@@ -0,0 +1,117 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "UI/ScoreboardViewModel.h"
+#include "GDKStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Scoreboard Diff"), STAT_GDKScoreboardDiff, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scoreboard Rows Changed"), STAT_GDKScoreboardRowsChanged, STATGROUP_GDKShooter);
+
+void UScoreboardViewModel::ApplyPlayerScores(const TArray<FPlayerScore>& Scores)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKScoreboardDiff);
+
+	NewRows.Reset(Scores.Num());
+	for (const FPlayerScore& Score : Scores)
+	{
+		ApplyRow(Score, NAME_None);
+	}
+	FinishApply();
+}
+
+void UScoreboardViewModel::ApplyTeamScores(const TArray<FTeamScore>& Scores)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GDKScoreboardDiff);
+
+	NewRows.Reset(Rows.Num());
+	for (const FTeamScore& Team : Scores)
+	{
+		for (const FPlayerScore& Score : Team.PlayerScores)
+		{
+			ApplyRow(Score, Team.TeamName);
+		}
+	}
+	FinishApply();
+}
+
+UScoreboardEntry* UScoreboardViewModel::FindRow(int32 PlayerId) const
+{
+	UScoreboardEntry* const* Entry = RowsByPlayerId.Find(PlayerId);
+	return Entry != nullptr ? *Entry : nullptr;
+}
+
+void UScoreboardViewModel::ApplyRow(const FPlayerScore& Score, FName TeamName)
+{
+	const int32 Index = NewRows.Num();
+
+	UScoreboardEntry*& Entry = RowsByPlayerId.FindOrAdd(Score.PlayerId);
+	if (Entry == nullptr)
+	{
+		Entry = NewObject<UScoreboardEntry>(this);
+		Entry->Score = Score;
+		Entry->TeamName = TeamName;
+		Entry->Index = Index;
+		NewRows.Add(Entry);
+
+		bOrderChanged = true;
+		INC_DWORD_STAT(STAT_GDKScoreboardRowsChanged);
+		RowChanged.Broadcast(EScoreboardRowChange::Insert, Entry, Index);
+		return;
+	}
+
+	// Already listed in this apply.
+	if (NewRows.IsValidIndex(Entry->Index) && NewRows[Entry->Index] == Entry)
+	{
+		return;
+	}
+
+	const bool bMoved = Entry->Index != Index;
+	const bool bUpdated = Entry->Score.Kills != Score.Kills || Entry->Score.Deaths != Score.Deaths
+		|| Entry->Score.PlayerName != Score.PlayerName || Entry->TeamName != TeamName;
+
+	Entry->Score = Score;
+	Entry->TeamName = TeamName;
+	Entry->Index = Index;
+	NewRows.Add(Entry);
+
+	if (bMoved)
+	{
+		bOrderChanged = true;
+		RowChanged.Broadcast(EScoreboardRowChange::Move, Entry, Index);
+	}
+	if (bUpdated)
+	{
+		RowChanged.Broadcast(EScoreboardRowChange::Update, Entry, Index);
+	}
+	if (bMoved || bUpdated)
+	{
+		INC_DWORD_STAT(STAT_GDKScoreboardRowsChanged);
+		Entry->OnChanged.Broadcast(Entry);
+	}
+}
+
+void UScoreboardViewModel::FinishApply()
+{
+	// Anything listed now has been moved across, so what is left in the old rows is no longer on the scoreboard.
+	for (UScoreboardEntry* Entry : Rows)
+	{
+		if (Entry->Index < NewRows.Num() && NewRows[Entry->Index] == Entry)
+		{
+			continue;
+		}
+
+		RowsByPlayerId.Remove(Entry->Score.PlayerId);
+		bOrderChanged = true;
+		INC_DWORD_STAT(STAT_GDKScoreboardRowsChanged);
+		RowChanged.Broadcast(EScoreboardRowChange::Remove, Entry, Entry->Index);
+		Entry->Index = INDEX_NONE;
+	}
+
+	Swap(Rows, NewRows);
+	NewRows.Reset();
+
+	if (bOrderChanged)
+	{
+		bOrderChanged = false;
+		RowsChanged.Broadcast();
+	}
+}
@@ -5,8 +5,11 @@
 #include "Characters/Components/EquippedComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GDKLogging.h"
+#include "GDKStats.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Holdable Actors"), STAT_GDKHoldableActors, STATGROUP_GDKShooter);
+
 AHoldable::AHoldable()
 {
  	// Default to not ticking
@@ -26,6 +29,13 @@ void AHoldable::BeginPlay()
 {
 	Super::BeginPlay();
 	OnMetaDataUpdated();
+	INC_DWORD_STAT(STAT_GDKHoldableActors);
+}
+
+void AHoldable::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	DEC_DWORD_STAT(STAT_GDKHoldableActors);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AHoldable::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -2,12 +2,17 @@
 
 #include "Weapons/InstantWeapon.h"
 
+#include "Controllers/Components/ClientFXPoolComponent.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/DamageType.h"
 #include "GDKLogging.h"
+#include "GDKRandom.h"
+#include "GDKStats.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_CYCLE_STAT(TEXT("Instant Weapon Fire"), STAT_GDKInstantWeaponFire, STATGROUP_GDKShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Authoritative Shots"), STAT_GDKAuthoritativeShots, STATGROUP_GDKShooter);
 
 AInstantWeapon::AInstantWeapon()
 {
@@ -20,6 +25,7 @@ AInstantWeapon::AInstantWeapon()
 	HitValidationTolerance = 50.0f;
 	DamageTypeClass = UDamageType::StaticClass();  // generic damage type
 	ShotVisualizationDelayTolerance = FTimespan::FromMilliseconds(3000.0f);
+	ImpactFX = nullptr;
 }
 
 void AInstantWeapon::StartPrimaryUse_Implementation()
@@ -54,10 +60,24 @@ void AInstantWeapon::DoFire_Implementation()
 		return;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_GDKInstantWeaponFire);
+
 	NextShotTime = UGameplayStatics::GetRealTimeSeconds(GetWorld()) + ShotInterval;
 	
 	FInstantHitInfo HitInfo = DoLineTrace();
-	if (HitInfo.bDidHit)
+	if (FiresAuthoritatively())
+	{
+		INC_DWORD_STAT(STAT_GDKAuthoritativeShots);
+
+		if (HitInfo.bDidHit && HitInfo.HitActor != nullptr)
+		{
+			DealDamage(HitInfo);
+		}
+		SpawnFX(HitInfo, HitInfo.bDidHit);
+		NotifyClientsOfHit(HitInfo, HitInfo.bDidHit);
+		AnnounceShot(HitInfo.bDidHit && HitInfo.HitActor ? HitInfo.HitActor->CanBeDamaged() : false);
+	}
+	else if (HitInfo.bDidHit)
 	{
 		ServerDidHit(HitInfo);
 		SpawnFX(HitInfo, true);  // Spawn the hit fx locally
@@ -114,7 +134,7 @@ FVector AInstantWeapon::GetLineTraceDirection()
 
 	if (SpreadToUse > 0)
 	{
-		auto Spread = FMath::RandPointInCircle(SpreadToUse);
+		const FVector2D Spread = FGDKRandom::RandPointInCircle(EGDKRandomStream::Spread, SpreadToUse);
 		Direction = Direction.Rotation().RotateVector(FVector(10000, Spread.X, Spread.Y));
 	}
 
@@ -136,6 +156,14 @@ void AInstantWeapon::SpawnFX(const FInstantHitInfo& HitInfo, bool bImpact)
 	}
 	
 	AInstantWeapon::OnRenderShot(HitInfo.Location, bImpact);
+
+	if (bImpact && ImpactFX != nullptr)
+	{
+		if (UClientFXPoolComponent* FXPool = UClientFXPoolComponent::Get(this))
+		{
+			FXPool->ShowImpact(ImpactFX, HitInfo.Location, (GetActorLocation() - HitInfo.Location).Rotation());
+		}
+	}
 }
 
 bool AInstantWeapon::ValidateHit(const FInstantHitInfo& HitInfo)
@@ -176,10 +204,21 @@ void AInstantWeapon::DealDamage(const FInstantHitInfo& HitInfo)
 	DmgEvent.DamageTypeClass = DamageTypeClass;
 	DmgEvent.HitInfo.ImpactPoint = HitInfo.Location;
 
-	if (APawn* Pawn = Cast<APawn>(GetOwner()))
+	// Weapons not held by a pawn, e.g. turrets, deal damage without an instigator.
+	APawn* Pawn = Cast<APawn>(GetOwner());
+	HitInfo.HitActor->TakeDamage(ShotBaseDamage, DmgEvent, Pawn != nullptr ? Pawn->GetController() : nullptr, this);
+}
+
+bool AInstantWeapon::FiresAuthoritatively() const
+{
+	if (!HasAuthority())
 	{
-		HitInfo.HitActor->TakeDamage(ShotBaseDamage, DmgEvent, Pawn->GetController(), this);
+		return false;
 	}
+
+	// AI controllers, and a listen server's own player, are locally controlled on the server.
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	return Pawn == nullptr || Pawn->IsLocallyControlled();
 }
 
 bool AInstantWeapon::ServerDidHit_Validate(const FInstantHitInfo& HitInfo)
@@ -189,7 +228,6 @@ bool AInstantWeapon::ServerDidHit_Validate(const FInstantHitInfo& HitInfo)
 
 void AInstantWeapon::ServerDidHit_Implementation(const FInstantHitInfo& HitInfo)
 {
-
 	bool bDoNotifyHit = false;
 
 	if (HitInfo.HitActor == nullptr)
@@ -0,0 +1,40 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BTTask_FindNearestHostile.generated.h"
+
+// [server] Sets BlackboardKey to the nearest hostile the UPerceptionRegistryComponent knows of within Radius, and fails
+// if there is none. Replaces reading enemies from engine perception, so a scan is a lookup in a few grid cells.
+UCLASS()
+class GDKSHOOTER_API UBTTask_FindNearestHostile : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_FindNearestHostile(const FObjectInitializer& ObjectInitializer);
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "Perception")
+	float Radius;
+
+	// Skip hostiles the pawn can't see. Only the nearest few are traced to.
+	UPROPERTY(EditAnywhere, Category = "Perception")
+	bool bRequireLineOfSight;
+
+	UPROPERTY(EditAnywhere, Category = "Perception", meta = (EditCondition = "bRequireLineOfSight"))
+	int32 MaxLineOfSightChecks;
+
+	UPROPERTY(EditAnywhere, Category = "Perception", meta = (EditCondition = "bRequireLineOfSight"))
+	TEnumAsByte<ECollisionChannel> LineOfSightCollisionChannel;
+
+	// Optional, set to the hostile's location when one is found.
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector LocationKey;
+};
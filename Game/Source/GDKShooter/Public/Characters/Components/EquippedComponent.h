@@ -10,6 +10,24 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHoldableUpdated, AHoldable*, NewHoldable);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBusyUpdated, bool, bIsBusy);
 
+class AHoldable;
+
+// A held item in the data only inventory, enough to recreate its holdable when it is next equipped.
+USTRUCT(BlueprintType)
+struct FHeldItemRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TSubclassOf<AHoldable> HoldableClass;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Mode = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	FGDKMetaData MetaData;
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class GDKSHOOTER_API UEquippedComponent : public UActorComponent
 {
@@ -29,6 +47,10 @@ public:
 	UFUNCTION(BlueprintCallable)
 		virtual void SpawnStarterTemplates(FGDKMetaData NewMetaData);
 
+	// [server] Puts the loadout back to the starter templates, for a character being reused from the pool.
+	// Starter holdables that are still held are kept, anything picked up since is destroyed.
+	void ResetToStarterTemplates();
+
 protected:
 
 	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly)
@@ -38,13 +60,26 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Holdables")
 		TArray<TSubclassOf<AHoldable>> StarterTemplates;
 
+	// Only the active holdable exists as an actor, the rest of the inventory is replicated as ItemRecords.
+	// Saves an entity per inactive holdable, at the cost of spawning a holdable on each switch.
+	UPROPERTY(EditDefaultsOnly, Category = "Holdables")
+		bool bDataOnlyInventory = false;
+
 // Held Items
 public:
 	UFUNCTION(BlueprintPure)
 	AHoldable* CurrentlyHeldItem() const;
 
+	// Switches to the holdable in a slot. If the owning client has the slot's holdable it switches straight away and
+	// reconciles once the server confirms, otherwise it switches when the server's change replicates.
+	UFUNCTION(BlueprintCallable)
+	void RequestEquip(int32 Index);
+
 	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerRequestEquip(int32 Index);
+	void ServerRequestEquip(int32 Index, int32 Sequence);
+
+	// The predicted slot while an equip request is waiting to be confirmed, otherwise CurrentHeldIndex.
+	int32 GetEffectiveHeldIndex() const;
 
 	UFUNCTION(BlueprintCallable)
 	void QuickToggle();
@@ -60,6 +95,12 @@ public:
 
 	bool HasHoldableAtIndex(int32 Index);
 
+	bool IsDataOnlyInventory() const { return bDataOnlyInventory; }
+
+	// The class held in a slot, whether or not its holdable currently exists.
+	UFUNCTION(BlueprintPure)
+	TSubclassOf<AHoldable> GetHoldableClassAtIndex(int32 Index) const;
+
 	UPROPERTY(BlueprintAssignable)
 	FHoldableUpdated HoldableUpdated;
 
@@ -73,6 +114,19 @@ protected:
 	UFUNCTION()
 	virtual void LocallyActivate(AHoldable* Holdable);
 
+	UFUNCTION()
+	void OnRep_AckedEquipSequence();
+
+	// [client] Slot switched to ahead of the server, or INDEX_NONE when no request is waiting to be confirmed.
+	int32 PredictedHeldIndex = INDEX_NONE;
+
+	// [client] Sequence number of the latest equip request.
+	int32 EquipSequence = 0;
+
+	// Sequence number of the latest equip request handled by the server.
+	UPROPERTY(ReplicatedUsing = OnRep_AckedEquipSequence)
+	int32 AckedEquipSequence = 0;
+
 	UPROPERTY()
 	AHoldable* LocallyActiveHoldable;
 
@@ -85,6 +139,16 @@ protected:
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Replicated)
 	bool bHeldItemsInitialised;
 
+	// Every held item when bDataOnlyInventory is set, HeldItems then only has the active holdable.
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Replicated)
+	TArray<FHeldItemRecord> ItemRecords;
+
+	// [server] Spawns the holdable for a slot from its record.
+	void MaterializeSlot(int32 Index);
+
+	// [server] Saves the state of a slot's holdable back to its record and destroys it.
+	void DematerializeSlot(int32 Index);
+
 	UFUNCTION()
 	bool HasAnyEmptySlots();
 
@@ -21,6 +21,7 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	friend class FSavedMove_GDKMovement;
+	friend class FNetworkPredictionData_Client_GDKMovement;
 
 	UGDKMovementComponent(const FObjectInitializer& ObjectInitializer);
 
@@ -28,6 +29,16 @@ public:
 
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 
+	// Sends moves faster while aiming or using a holdable, and slower while the measured upstream is over MoveUpstreamBudget.
+	virtual float GetClientNetSendDeltaTime(const APlayerController* PC, const FNetworkPredictionData_Client_Character* ClientData, const FSavedMovePtr& NewMove) const override;
+
+	virtual void CallServerMove(const FSavedMove_Character* NewMove, const FSavedMove_Character* OldMove) override;
+
+	virtual void OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode) override;
+
+	// Logs the upstream move rate and correction rate of the local player, also available as the GDK.Movement.Stats console command.
+	void LogMoveStats() const;
+
 	// Sets whether the character is trying to sprint.
 	void SetWantsToSprint(bool bSprinting);
 
@@ -39,10 +50,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sprint")
 	void SetSprintEnabled(bool bSprintEnabled);
 	
-	// Set if the character should be aiming
-	UFUNCTION(BlueprintCallable, Server, Reliable, WithValidation)
-	void ServerSetAiming(bool NewValue);
-
+	// Set if the character should be aiming, sent to the server with the character's moves.
 	UFUNCTION(BlueprintCallable)
 	void SetAiming(bool NewValue);
 
@@ -103,6 +111,7 @@ private:
 	uint8 bWasSprintingLastFrame : 1;
 
 	// If true, the player is aiming, should therefore move slower, and should not be allowed to sprint.
+	// Only replicated to simulated proxies, the owner sends it in its saved moves.
 	UPROPERTY(VisibleAnywhere, ReplicatedUsing = OnRep_IsAiming)
 	bool bIsAiming;
 
@@ -134,6 +143,26 @@ private:
 	// Multiply acceleration by this factor when aiming.
 	UPROPERTY(EditAnywhere, Category = "Character Movement (General Settings)")
 	float JogAcceleration;
+
+	// Adapt how often moves are sent to the server, instead of always using the engine's rate.
+	UPROPERTY(EditAnywhere, Category = "Character Movement (Networking)")
+	bool bAdaptiveMoveSendRate;
+
+	// Seconds between moves sent while aiming or using a holdable, when position errors are most noticeable.
+	UPROPERTY(EditAnywhere, Category = "Character Movement (Networking)")
+	float LatencySensitiveSendDeltaTime;
+
+	// Seconds between moves sent while bandwidth is constrained, more moves are combined into each one sent.
+	UPROPERTY(EditAnywhere, Category = "Character Movement (Networking)")
+	float ConstrainedSendDeltaTime;
+
+	// Bandwidth is constrained when the move upstream in bytes per second goes over this.
+	UPROPERTY(EditAnywhere, Category = "Character Movement (Networking)")
+	float MoveUpstreamBudget;
+
+	// Bandwidth is also constrained when the player's net speed is below this.
+	UPROPERTY(EditAnywhere, Category = "Character Movement (Networking)")
+	int32 ConstrainedNetSpeed;
 };
 
 class FSavedMove_GDKMovement : public FSavedMove_Character
@@ -151,6 +180,7 @@ public:
 
 private:
 	uint8 bSavedWantsToSprint : 1;
+	uint8 bSavedIsAiming : 1;
 };
 
 class FNetworkPredictionData_Client_GDKMovement : public FNetworkPredictionData_Client_Character
@@ -161,4 +191,23 @@ public:
 	typedef FNetworkPredictionData_Client_Character Super;
 
 	virtual FSavedMovePtr AllocateNewMove() override;
+
+	// Picks the send interval for UGDKMovementComponent::GetClientNetSendDeltaTime.
+	float GetAdaptiveSendDeltaTime(const UGDKMovementComponent& Movement, const APlayerController* PC, float DefaultDeltaTime) const;
+
+	void RecordServerMove(int32 NumMoves, int32 Bytes, float Now);
+	void RecordCorrection(float Now);
+
+	// Rates over the last full second.
+	float MovesPerSecond;
+	float UpstreamBytesPerSecond;
+	float CorrectionsPerSecond;
+
+private:
+	void UpdateWindow(float Now);
+
+	float WindowStartTime;
+	int32 WindowMoves;
+	int32 WindowBytes;
+	int32 WindowCorrections;
 };
@@ -39,6 +39,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	bool GrantHealth(float Value);
 
+	// [server] Back to full health and no armour, for a character being reused from the pool.
+	void ResetHealth();
+
 	UFUNCTION(BlueprintPure)
 	FORCEINLINE float GetCurrentHealth() const
 	{
@@ -28,9 +28,19 @@ public:
 	AGDKCharacter(const FObjectInitializer& ObjectInitializer);
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// [server] Brings a pooled character back into play at SpawnTransform, with full health, no team and its starter loadout.
+	void ResetForRespawn(const FTransform& SpawnTransform);
+
+	// [server] Unpossesses, hides and parks the character so it can be kept in the UCharacterPoolComponent.
+	void ParkInPool(const FVector& ParkingLocation);
+
+	UHealthComponent* GetHealthComponent() const { return HealthComponent; }
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(Category = Character, VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	UHealthComponent* HealthComponent;
@@ -78,12 +88,29 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void StartRagdoll();
 
+	// [client + server] Undoes StartRagdoll, so the character can be reused.
+	void StopRagdoll();
+
+	// Bumped by the server whenever the character is parked in or taken from the pool, so clients undo their ragdoll too.
+	UPROPERTY(ReplicatedUsing = OnRep_PoolGeneration)
+	int32 PoolGeneration;
+
+	UFUNCTION()
+	void OnRep_PoolGeneration();
+
 private:
 	UFUNCTION()
 	void DeleteSelf();
 
 	FTimerHandle DeletionTimer;
 	FTimerDelegate DeletionDelegate;
+
+	// What StartRagdoll changes, captured so StopRagdoll can put it back.
+	FTransform MeshRelativeTransform;
+	FName MeshCollisionProfile;
+	TEnumAsByte<ECollisionEnabled::Type> MeshCollisionEnabled;
+	TEnumAsByte<ECollisionEnabled::Type> CapsuleCollisionEnabled;
+	TArray<TPair<TWeakObjectPtr<USceneComponent>, FTransform>> RagdollMovedComponents;
 	
 public:
 	float TakeDamage(float Damage, const struct FDamageEvent& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
@@ -0,0 +1,139 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ClientFXPoolComponent.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UParticleSystem;
+class UParticleSystemComponent;
+class UTextRenderComponent;
+
+// [client] Recycles floating damage numbers and impact emitters for the local player, instead of spawning an actor or
+// emitter for every hit. New effects are queued and at most SpawnBudgetPerFrame of them start each frame. Effects too
+// far from the camera are dropped, and effects landing close to one still queued or just started are merged into it.
+// The pooled components belong to a local, visible FX actor, as the controller is hidden and its components don't render.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UClientFXPoolComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClientFXPoolComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// The local player's pool, null on servers.
+	static UClientFXPoolComponent* Get(const UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category = "FX")
+	void ShowDamageNumber(FVector Location, float Damage, FLinearColor Color);
+
+	UFUNCTION(BlueprintCallable, Category = "FX")
+	void ShowImpact(UParticleSystem* Template, FVector Location, FRotator Rotation);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Effects started per frame across both pools. The rest wait for later frames.
+	UPROPERTY(EditDefaultsOnly, Category = "FX")
+	int32 SpawnBudgetPerFrame;
+
+	// Effects further than this from the camera are not shown.
+	UPROPERTY(EditDefaultsOnly, Category = "FX")
+	float CullDistance;
+
+	// Effects within this distance of a queued or just started one are merged into it.
+	UPROPERTY(EditDefaultsOnly, Category = "FX")
+	float MergeRadius;
+
+	// How long after starting a damage number can still take on merged damage.
+	UPROPERTY(EditDefaultsOnly, Category = "FX")
+	float MergeWindow;
+
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Damage Numbers")
+	int32 MaxDamageNumbers;
+
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Damage Numbers")
+	float DamageNumberLifetime;
+
+	// Upwards speed of a damage number, in units per second.
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Damage Numbers")
+	float DamageNumberRiseSpeed;
+
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Damage Numbers")
+	float DamageNumberSize;
+
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Damage Numbers")
+	UMaterialInterface* DamageNumberMaterial;
+
+	// Scalar parameter of DamageNumberMaterial faded from 1 to 0 over the lifetime, if set.
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Damage Numbers")
+	FName DamageNumberFadeParameter;
+
+	UPROPERTY(EditDefaultsOnly, Category = "FX|Impacts")
+	int32 MaxImpacts;
+
+private:
+	struct FPendingDamageNumber
+	{
+		FVector Location;
+		float Damage;
+		FLinearColor Color;
+	};
+
+	struct FPendingImpact
+	{
+		UParticleSystem* Template;
+		FVector Location;
+		FRotator Rotation;
+	};
+
+	struct FDamageNumberSlot
+	{
+		UTextRenderComponent* Text = nullptr;
+		UMaterialInstanceDynamic* Material = nullptr;
+		FVector StartLocation = FVector::ZeroVector;
+		float Damage = 0.f;
+		float Age = 0.f;
+		bool bActive = false;
+	};
+
+	struct FImpactSlot
+	{
+		UParticleSystemComponent* Emitter = nullptr;
+		float StartTime = 0.f;
+	};
+
+	// False if there is no camera yet.
+	bool GetCameraLocation(FVector& OutLocation) const;
+
+	bool ShouldCull(const FVector& Location) const;
+
+	void StartDamageNumber(const FPendingDamageNumber& Pending, const FVector& CameraLocation);
+	void StartImpact(const FPendingImpact& Pending);
+
+	// Free slot, or the oldest one if all are in use.
+	FDamageNumberSlot& AcquireDamageNumberSlot();
+	FImpactSlot& AcquireImpactSlot();
+
+	void UpdateDamageNumbers(float DeltaTime, const FVector& CameraLocation);
+
+	TArray<FPendingDamageNumber> PendingDamageNumbers;
+	TArray<FPendingImpact> PendingImpacts;
+
+	TArray<FDamageNumberSlot> DamageNumberSlots;
+	TArray<FImpactSlot> ImpactSlots;
+
+	// Owns the pooled components. Spawned on the local client only, and never replicated.
+	UPROPERTY(Transient)
+	AActor* FXActor;
+
+	// Keeps the pooled components alive, nothing else references them.
+	UPROPERTY(Transient)
+	TArray<UObject*> PooledObjects;
+};
@@ -30,11 +30,12 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FControllerEvent KillEvent;
 
+	// Only the player id is sent, the name is resolved on the client through the UPlayerNameTableComponent.
 	UFUNCTION(Client, Reliable)
-	void ClientInformOfKill(const FString& VictimName, int32 VictimId);
+	void ClientInformOfKill(int32 VictimId);
 
 	UFUNCTION(Client, Reliable)
-	void ClientInformOfDeath(const FString& KillerName, int32 KillerId);
+	void ClientInformOfDeath(int32 KillerId);
 	
 	UPROPERTY(BlueprintAssignable)
 	FKillDetailsEvent KillDetailsEvent;
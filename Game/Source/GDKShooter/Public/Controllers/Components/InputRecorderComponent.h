@@ -0,0 +1,71 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputRecorderComponent.generated.h"
+
+// A local player's input and requests on one frame.
+struct FRecordedInputFrame
+{
+	enum EFlags : uint8
+	{
+		HasPawn = 1 << 0,
+		Jump = 1 << 1,
+		Crouch = 1 << 2,
+		Sprint = 1 << 3,
+		PrimaryUse = 1 << 4,
+		Aim = 1 << 5
+	};
+
+	// Seconds since recording started.
+	float Time = 0.f;
+	// Only used to place the pawn when it (re)spawns, movement is replayed from MovementInput.
+	FVector Location = FVector::ZeroVector;
+	FVector MovementInput = FVector::ZeroVector;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	int32 HeldIndex = INDEX_NONE;
+	uint8 Flags = 0;
+
+	bool HasFlag(EFlags Flag) const { return (Flags & Flag) != 0; }
+};
+
+// Everything one player did during a session.
+struct GDKSHOOTER_API FInputRecording
+{
+	FString PlayerName;
+	TArray<FRecordedInputFrame> Frames;
+
+	// Reads or writes the recording. Returns false if the archive does not hold a recording of the current version.
+	bool Serialize(FArchive& Ar);
+
+	bool SaveToFile(const FString& Path);
+	bool LoadFromFile(const FString& Path);
+};
+
+// [client] Records the local player's movement, aim, equip and fire input every frame when the client is started with
+// -RecordInput, and writes it to Saved/InputRecordings when play ends. UInputReplayComponent replays recordings on a
+// headless server, so two builds can be profiled on the same workload.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UInputRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInputRecorderComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void CaptureFrame(const APawn* Pawn);
+
+	FInputRecording Recording;
+
+	// World time the first frame was captured at.
+	float StartTime;
+	bool bStarted;
+};
@@ -20,6 +20,7 @@ public:
 	AGDKPlayerController();
 
 	virtual void Tick(float DeltaTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	FPawnEvent& OnPawn() { return PawnEvent; }
 
@@ -51,6 +52,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	class USpringArmComponent* CameraBoom;
 
+	// Records the local player's input with -RecordInput, for replaying on a server while profiling.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class UInputRecorderComponent* InputRecorder;
+
+	// [client] Recycles damage numbers and impact effects for the local player.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class UClientFXPoolComponent* FXPool;
+
 	virtual void GetPlayerViewPoint(FVector& out_Location, FRotator& out_Rotation) const override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
@@ -84,4 +93,14 @@ private:
 	float DeleteCharacterDelay;
 
 	FTimerHandle RespawnTimerHandle;
+
+	// [server] Records the start of a spawn for the USpawnLatencyTrackerComponent.
+	void RecordSpawnRequest();
+
+	// Server world time of the last spawn request, so the owning client can measure how long its pawn took to arrive.
+	UPROPERTY(Replicated)
+	float LastSpawnRequestTime;
+
+	// [client] The request time already measured, so a stale LastSpawnRequestTime isn't counted twice.
+	float LastMeasuredSpawnRequestTime;
 };
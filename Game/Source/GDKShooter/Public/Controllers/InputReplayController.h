@@ -0,0 +1,39 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "Controllers/Components/InputRecorderComponent.h"
+#include "InputReplayController.generated.h"
+
+// [server] Plays back one player's recorded input through the same entry points the player's input is bound to.
+// A plain controller rather than an AI controller, so the pawn is treated like a player's rather than an NPC's.
+UCLASS(NotBlueprintable)
+class GDKSHOOTER_API AInputReplayController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	AInputReplayController();
+
+	virtual void Tick(float DeltaTime) override;
+
+	// Whenever the recording has a pawn and this controller doesn't, one is spawned the way a player's is and moved to
+	// the recorded location.
+	void StartReplay(TSharedRef<const FInputRecording> InRecording);
+
+	bool IsFinished() const { return !Recording.IsValid() || NextFrame >= Recording->Frames.Num(); }
+
+protected:
+	void ApplyFrame(const FRecordedInputFrame& Frame, bool bApplyMovement);
+	void SpawnPawn(const FRecordedInputFrame& Frame);
+
+	TSharedPtr<const FInputRecording> Recording;
+
+	int32 NextFrame;
+	float StartTime;
+
+	// What has been applied to the pawn so far, to find presses and releases.
+	FRecordedInputFrame Applied;
+};
@@ -0,0 +1,39 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+enum class EGDKRandomStream : uint8
+{
+	// Weapon spread.
+	Spread,
+	// Player start shuffles and picks.
+	Spawn,
+	Count
+};
+
+// Random streams for gameplay randomness that has to be repeatable when replaying recorded input.
+// Streams are seeded from -GDKRandomSeed=<seed> when given, otherwise randomly. Each stream has its own sequence,
+// so extra shots don't change which player starts are picked.
+class GDKSHOOTER_API FGDKRandom
+{
+public:
+	static FRandomStream& GetStream(EGDKRandomStream Stream);
+
+	// Reseeds every stream, e.g. at the start of a replay.
+	static void SetSeed(int32 Seed);
+
+	static bool HasFixedSeed();
+
+	// Same distribution as FMath::RandPointInCircle.
+	static FVector2D RandPointInCircle(EGDKRandomStream Stream, float CircleRadius);
+
+private:
+	static void Initialize();
+
+	static FRandomStream Streams[(int32)EGDKRandomStream::Count];
+	static bool bInitialized;
+	static bool bFixedSeed;
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "GenericTeamAgentInterface.h"
 #include "GDKShooterFunctionLibrary.generated.h"
@@ -22,4 +24,13 @@ public:
 
 	UFUNCTION(BlueprintPure, Category = "Teams")
 	static FGenericTeamId GetGenericTeamId(AActor* Actor);
+
+	// The component of type T on the world's game state, nullptr if there is no game state yet or it has none.
+	template <class T>
+	static T* GetGameStateComponent(const UObject* WorldContextObject)
+	{
+		const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+		const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+		return GameState ? GameState->FindComponentByClass<T>() : nullptr;
+	}
 };
@@ -0,0 +1,81 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "BenchmarkRunnerComponent.generated.h"
+
+class AGDKCharacter;
+class AHoldable;
+
+// Timings of one benchmark at one scale, in nanoseconds per operation.
+struct FBenchmarkResult
+{
+	FString Name;
+	int32 NumActors = 0;
+	int32 OpsPerRound = 0;
+	// Per round, divided by OpsPerRound.
+	TArray<double> NsPerOp;
+};
+
+// [server] Micro-benchmarks the hot server paths of the shooter: hit validation, authoritative fire, damage, kill
+// scoring and score sorting, team spawns, and holdable grant and equip, with 10, 100 and 1000 characters or players by
+// default. Characters are spawned into the running map, so the numbers include whatever the GameState's other
+// components add to each call.
+// Runs when the server is started with -GDKBenchmark=<label> (see ci/benchmarks), or on GDK.RunBenchmarks in PIE, and
+// writes the results to Saved/Profiling/Benchmark-<label>.json. A server started with -GDKBenchmark exits when done.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UBenchmarkRunnerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UBenchmarkRunnerComponent();
+
+	static UBenchmarkRunnerComponent* Get(const UObject* WorldContextObject);
+
+	// [server] Runs every benchmark at every scale within this frame and writes the results. Returns the path written.
+	FString RunBenchmarks(const FString& Label);
+
+protected:
+	virtual void BeginPlay() override;
+
+	void RunAndExit();
+
+	void RunScale(int32 NumActors, TArray<FBenchmarkResult>& OutResults);
+
+	// Times Rounds calls of Round after one untimed warm up. Prepare runs untimed before every round.
+	void Measure(const FString& Name, int32 NumActors, int32 OpsPerRound, TFunctionRef<void()> Prepare, TFunctionRef<void()> Round, TArray<FBenchmarkResult>& OutResults);
+
+	TArray<AGDKCharacter*> SpawnCharacters(int32 NumActors);
+
+	FString WriteResults(const FString& Label, const TArray<FBenchmarkResult>& Results) const;
+
+	// Numbers of characters and players each benchmark is run with.
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	TArray<int32> Scales;
+
+	// Timed rounds per benchmark and scale.
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	int32 Rounds;
+
+	// Seconds to let the map settle before running with -GDKBenchmark.
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float StartDelay;
+
+	// Defaults to the game mode's default pawn class when that is a GDK character.
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	TSubclassOf<AGDKCharacter> CharacterClass;
+
+	// Instant weapon validating hits, and the holdable granted and equipped. Defaults to the characters' starting weapon.
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	TSubclassOf<class AInstantWeapon> WeaponClass;
+
+	// Characters are spawned in a grid from here, out of the way of the map.
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	FVector SpawnOrigin;
+
+	FTimerHandle StartTimerHandle;
+	FString PendingLabel;
+};
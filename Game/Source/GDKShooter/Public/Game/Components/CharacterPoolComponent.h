@@ -0,0 +1,77 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Controller.h"
+#include "TimerManager.h"
+#include "CharacterPoolComponent.generated.h"
+
+class AGameModeBase;
+class AGDKCharacter;
+
+// Keeps dead characters, and a few created up front, parked out of sight so respawns can reuse them
+// instead of creating a character and its holdables from scratch. Each server worker parks its characters below
+// a player start it has authority over, so parked characters stay on the worker that pooled them.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UCharacterPoolComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCharacterPoolComponent();
+
+	// [server] Takes a character from the pool if there is one on the game state and it holds the controller's
+	// default pawn class, otherwise falls back to AGameModeBase::SpawnDefaultPawnFor.
+	static APawn* SpawnPawnFor(AGameModeBase* GameMode, AController* Controller, AActor* StartSpot);
+
+	// [server] Parks a dead character in the pool. Returns false if the pool doesn't want it, in which case the caller should destroy it.
+	bool Release(AGDKCharacter* Character);
+
+	static UCharacterPoolComponent* Get(const UObject* WorldContextObject);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	AGDKCharacter* Acquire(const FTransform& SpawnTransform);
+
+	// False until Unreal load balancing, if there is any, is ready to say which part of the map this worker has.
+	bool CanPark() const;
+
+	// Below a player start this worker has authority over, worked out the first time it is needed.
+	FVector GetParkingLocation();
+
+	// Creates a few characters each time it runs, until InitialPoolSize have been made.
+	void WarmUp();
+
+	// Should match the game mode's default pawn class, other classes are never pooled.
+	UPROPERTY(EditDefaultsOnly)
+	TSubclassOf<AGDKCharacter> PooledCharacterClass;
+
+	// Characters created up front.
+	UPROPERTY(EditDefaultsOnly)
+	int32 InitialPoolSize = 8;
+
+	// The most characters kept in the pool, any released beyond this are destroyed.
+	UPROPERTY(EditDefaultsOnly)
+	int32 MaxPoolSize = 32;
+
+	// Characters created per warm up step, so warming up doesn't cause a hitch of its own.
+	UPROPERTY(EditDefaultsOnly)
+	int32 WarmUpBatchSize = 2;
+
+	// Height pooled characters wait at, out of sight and out of the way.
+	UPROPERTY(EditDefaultsOnly)
+	float ParkingHeight = -100000.f;
+
+	UPROPERTY()
+	TArray<AGDKCharacter*> AvailableCharacters;
+
+	int32 NumWarmedUp;
+
+	TOptional<FVector> ParkingLocation;
+
+	FTimerHandle WarmUpTimerHandle;
+};
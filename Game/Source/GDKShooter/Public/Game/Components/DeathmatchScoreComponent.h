@@ -15,7 +15,8 @@ struct FPlayerScore {
 	UPROPERTY(BlueprintReadOnly)
 	int32 PlayerId;
 
-	UPROPERTY(BlueprintReadOnly)
+	// Not replicated: resolved locally from the UPlayerNameTableComponent using PlayerId.
+	UPROPERTY(BlueprintReadOnly, NotReplicated)
 	FString PlayerName;
 
 	UPROPERTY(BlueprintReadOnly)
@@ -48,12 +49,28 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FScoreChangeEvent ScoreEvent;
 
+	// [server] Adds to a player's kills and deaths, used for batched updates from other workers.
+	void ApplyScoreDelta(int32 PlayerId, int32 Kills, int32 Deaths);
+
+	// [server] Replaces all scores, e.g. when restoring from a checkpoint.
+	void RestorePlayerScores(const TArray<FPlayerScore>& Scores);
+
+	// Most kills first, ties broken by fewest deaths.
+	static void SortPlayerScores(TArray<FPlayerScore>& Scores);
+
+	// Fills in PlayerName on each score from the match name table.
+	static void ResolvePlayerNames(const UObject* WorldContextObject, TArray<FPlayerScore>& Scores);
+
 protected:
+	virtual void BeginPlay() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	UFUNCTION()
 	void OnRep_PlayerScores();
 
+	UFUNCTION()
+	void OnPlayerNamesChanged();
+
 	UPROPERTY(ReplicatedUsing = OnRep_PlayerScores)
 	TArray<FPlayerScore> PlayerScoreArray;
 
@@ -0,0 +1,48 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Controllers/Components/InputRecorderComponent.h"
+#include "Metrics/GDKHistogram.h"
+#include "InputReplayComponent.generated.h"
+
+class AInputReplayController;
+
+// [server] Replays every recording written by UInputRecorderComponent in the directory given by -InputReplay=<dir>, one
+// controller per recording, then writes the game thread time of each kind of replayed input (spawn, movement, equip, aim
+// and primary use, see AInputReplayController) and of whole frames to Saved/Profiling/InputReplay-<label>.csv and exits. The label comes from -InputReplayLabel=, e.g. a build or commit.
+// Gameplay randomness is seeded from -GDKRandomSeed= (0 by default), so with a fixed time step (-benchmark -fps=30)
+// two builds replay the same workload and their CSVs can be compared. See ci/input-replay.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UInputReplayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInputReplayComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+	void StartReplay();
+	void FinishReplay();
+
+	// Seconds to let the map settle before replaying.
+	UPROPERTY(EditDefaultsOnly, Category = "Input Replay")
+	float StartDelay;
+
+	UPROPERTY()
+	TArray<AInputReplayController*> Controllers;
+
+	TArray<TSharedRef<const FInputRecording>> Recordings;
+	FString Label;
+	FTimerHandle StartTimerHandle;
+
+	// Real time per frame while replaying, in milliseconds.
+	FGDKHistogram FrameTimes;
+	double LastFrameSeconds;
+};
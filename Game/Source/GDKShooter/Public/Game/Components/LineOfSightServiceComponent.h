@@ -0,0 +1,98 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "LineOfSightServiceComponent.generated.h"
+
+// Answers AI sight checks for characters. Results are cached per observer and target for a short time, and once the
+// per frame budget of synchronous traces is used up, cache misses are answered from the last result and refreshed
+// with async traces instead.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API ULineOfSightServiceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	ULineOfSightServiceComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// [server] Same contract as IAISightTargetInterface::CanBeSeenFrom, for a target that is visible if any of TargetPoints is.
+	// A target that has never been checked and can't be traced within the budget this frame is reported as not seen.
+	bool CanBeSeenFrom(const AActor* Target, const TArray<FVector>& TargetPoints, ECollisionChannel Channel, const FVector& ObserverLocation,
+		FVector& OutSeenLocation, int32& NumberOfLoSChecksPerformed, float& OutSightStrength, const AActor* Observer);
+
+	static ULineOfSightServiceComponent* Get(const UObject* WorldContextObject);
+
+protected:
+	// Seconds a result is reused for.
+	UPROPERTY(EditDefaultsOnly)
+	float CacheLifetime = 0.2f;
+
+	// Stop at the first visible point, sight strength is then always 1. Async refreshes always trace every point.
+	UPROPERTY(EditDefaultsOnly)
+	bool bStopAtFirstVisiblePoint = true;
+
+	// Synchronous traces per frame.
+	UPROPERTY(EditDefaultsOnly)
+	int32 SyncTraceBudget = 64;
+
+	// Async traces started per frame.
+	UPROPERTY(EditDefaultsOnly)
+	int32 AsyncTraceBudget = 128;
+
+	// Observer, then target.
+	typedef TPair<TWeakObjectPtr<const AActor>, TWeakObjectPtr<const AActor>> FLineOfSightKey;
+
+	struct FLineOfSightResult
+	{
+		FVector SeenLocation = FVector::ZeroVector;
+		float SightStrength = 0.f;
+		float Time = 0.f;
+		bool bVisible = false;
+		bool bRefreshQueued = false;
+	};
+
+	struct FQueuedCheck
+	{
+		FLineOfSightKey Key;
+		FVector ObserverLocation;
+		TArray<FVector> TargetPoints;
+		ECollisionChannel Channel;
+	};
+
+	struct FPendingCheck
+	{
+		FLineOfSightKey Key;
+		int32 NumPoints = 0;
+		int32 NumOutstanding = 0;
+		int32 NumVisible = 0;
+		FVector SeenLocation = FVector::ZeroVector;
+	};
+
+	bool TraceNow(const AActor* Target, const TArray<FVector>& TargetPoints, ECollisionChannel Channel, const FVector& ObserverLocation,
+		const AActor* Observer, FLineOfSightResult& OutResult, int32& OutNumTraces) const;
+
+	void QueueRefresh(const FLineOfSightKey& Key, const TArray<FVector>& TargetPoints, ECollisionChannel Channel, const FVector& ObserverLocation);
+
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	// Drops results that are long expired or whose actors are gone.
+	void SweepCache(float Now);
+
+	TMap<FLineOfSightKey, FLineOfSightResult> Cache;
+
+	TArray<FQueuedCheck> QueuedChecks;
+	TMap<uint32, FPendingCheck> PendingChecks;
+	uint32 NextPendingCheckId;
+
+	FTraceDelegate TraceDelegate;
+
+	uint64 BudgetFrame;
+	int32 SyncTracesThisFrame;
+	float LastSweepTime;
+};
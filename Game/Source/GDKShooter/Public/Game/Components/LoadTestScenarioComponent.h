@@ -0,0 +1,164 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Metrics/GDKHistogram.h"
+#include "TimerManager.h"
+#include "LoadTestScenarioComponent.generated.h"
+
+// Limits a load test phase must stay within. Zero means unchecked.
+USTRUCT(BlueprintType)
+struct FLoadTestThresholds
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxFrameTimeP50Ms = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxFrameTimeP99Ms = 0.f;
+
+	// 90th percentile of each client connection's outgoing bytes per second.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxOutBytesPerConnectionP90 = 0.f;
+
+	// 90th percentile of each client connection's incoming bytes per second.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxInBytesPerConnectionP90 = 0.f;
+
+	// RPCs sent by the worker, of every function, per second.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxRpcsPerSecond = 0.f;
+
+	// Per function limits on RPCs sent by the worker per second.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TMap<FName, float> MaxRpcsPerSecondByFunction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	int32 MaxEntities = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FLoadTestPhase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FString Name;
+
+	// Seconds the phase lasts.
+	UPROPERTY(BlueprintReadOnly)
+	float Duration = 0.f;
+
+	// Fraction of the simulated players that quit when the phase starts.
+	UPROPERTY(BlueprintReadOnly)
+	float DisconnectFraction = 0.f;
+
+	// Seconds at the start of the phase left out of the measurements, e.g. while players join or leave.
+	UPROPERTY(NotReplicated)
+	float SettleTime = 0.f;
+
+	UPROPERTY(NotReplicated)
+	FLoadTestThresholds Thresholds;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLoadTestPhaseEvent, const FLoadTestPhase&, Phase);
+
+// Runs a scripted load test scenario, loaded by each server worker from the JSON file given by -LoadTestScenario=<path>.
+// The game state's authoritative worker steps through the phases once the first player has joined, and replicates the current
+// one, so other workers measure the same phase and simulated players can disconnect. Simulated players otherwise play as their
+// behavior tree does, scenarios don't steer them.
+// Each worker records its frame time, bandwidth per client connection, RPCs sent per function and entity counts per phase.
+// RPCs are counted by UGDKNetDriver, so engine RPCs are included and RPCs received from clients are not.
+// When the last phase ends, each worker writes its results, and whether each phase stayed within its thresholds, to
+// Saved/Profiling/LoadTest-<scenario>-<worker>.json, then exits with a non-zero code on failure. See ci/load-tests.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API ULoadTestScenarioComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	ULoadTestScenarioComponent();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	static ULoadTestScenarioComponent* Get(const UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintPure, Category = "Load Test")
+	const FLoadTestPhase& GetCurrentPhase() const { return CurrentPhase; }
+
+	UFUNCTION(BlueprintPure, Category = "Load Test")
+	bool IsRunning() const { return Phases.IsValidIndex(CurrentPhaseIndex); }
+
+	UPROPERTY(BlueprintAssignable)
+	FLoadTestPhaseEvent PhaseChanged;
+
+protected:
+	virtual void BeginPlay() override;
+
+	bool LoadScenario(const FString& Path);
+
+	// [authority] Starts the first phase once a player has joined, and moves on when the current phase's time is up.
+	void AdvanceScenario(double Now);
+	void SetPhase(int32 PhaseIndex);
+
+	// Writes the report and exits.
+	void Finish();
+	void Exit(bool bPassed);
+
+	// Samples the per second metrics: connection bandwidth, entity counts and RPCs sent.
+	void SampleMetrics();
+
+	// Adds the RPCs sent since the last call to the measured phase, or drops them if it isn't being measured.
+	void CollectRpcCounts();
+
+	bool CheckThresholds(int32 PhaseIndex, TArray<FString>& OutFailures) const;
+	FString WriteReport(bool bPassed, const TArray<FString>& Failures) const;
+
+	UFUNCTION()
+	void OnRep_CurrentPhase();
+
+	// [client] Quits if this is a simulated player picked to disconnect in the current phase.
+	void ApplyPhaseToSimulatedPlayer();
+
+	UPROPERTY(ReplicatedUsing = OnRep_CurrentPhase)
+	FLoadTestPhase CurrentPhase;
+
+	// INDEX_NONE before the scenario starts, and the number of phases once it has finished.
+	UPROPERTY(Replicated)
+	int32 CurrentPhaseIndex;
+
+	// Seconds the authoritative worker waits after finishing, so the other workers see the scenario finish.
+	UPROPERTY(EditDefaultsOnly)
+	float ExitDelay = 5.f;
+
+	FString ScenarioName;
+	TArray<FLoadTestPhase> Phases;
+
+	struct FPhaseMetrics
+	{
+		// Milliseconds the game thread was busy each frame, not counting the wait for the tick rate.
+		FGDKHistogram FrameTime = FGDKHistogram(0.1, 1.1, 100);
+		FGDKHistogram OutBytesPerConnection = FGDKHistogram(64.0, 1.25, 60);
+		FGDKHistogram InBytesPerConnection = FGDKHistogram(64.0, 1.25, 60);
+		TMap<FName, int32> RpcCounts;
+		int32 MaxEntities = 0;
+		int32 MaxAuthoritativeEntities = 0;
+		int32 MaxConnections = 0;
+		float MeasuredTime = 0.f;
+	};
+
+	TArray<FPhaseMetrics> PhaseMetrics;
+
+	// The phase this worker is measuring, follows CurrentPhaseIndex.
+	int32 MeasuredPhaseIndex;
+	double PhaseStartTime;
+	double LastSampleTime;
+	bool bMeasuring;
+	bool bFinished;
+
+	FTimerHandle ExitTimerHandle;
+};
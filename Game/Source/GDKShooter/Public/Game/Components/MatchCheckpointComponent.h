@@ -0,0 +1,94 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Components/ActorComponent.h"
+#include "Game/Components/DeathmatchScoreComponent.h"
+#include "Game/Components/MatchStateComponent.h"
+#include "Game/Components/PlayerNameTableComponent.h"
+#include "Game/Components/TeamDeathmatchScoreComponent.h"
+#include "TimerManager.h"
+#include "MatchCheckpointComponent.generated.h"
+
+// State of a single UTimerComponent on the game state, identified by its component name.
+struct FTimerCheckpoint
+{
+	FName ComponentName;
+	int32 TimeLeft = 0;
+	bool bIsRunning = false;
+	bool bHasFinished = false;
+};
+
+// Everything needed to resume a match on a restarted worker.
+struct FMatchCheckpoint
+{
+	int64 WrittenAtUtcTicks = 0;
+	bool bHasMatchState = false;
+	EMatchState MatchState = EMatchState::PreGame;
+	TArray<FPlayerNameEntry> PlayerNames;
+	TArray<FPlayerScore> PlayerScores;
+	TArray<FTeamScore> TeamScores;
+	TArray<FTimerCheckpoint> Timers;
+	// PlayerId to TeamId, from the UTeamDeathmatchSpawnerComponent.
+	TMap<int32, int32> PlayerTeams;
+
+	// Reads or writes the checkpoint. Returns false if the archive does not hold a checkpoint of the current version.
+	bool Serialize(FArchive& Ar);
+};
+
+// Periodically writes the match state held by the other game state components to local disk,
+// so that a worker which crashes mid-match can pick up where it left off when it is restarted.
+// Checkpoints are keyed by the -MatchSessionId=<id> the server is started with, and are off without one.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UMatchCheckpointComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMatchCheckpointComponent();
+
+	// [server] Captures the match state and writes it to disk on a background thread.
+	UFUNCTION(BlueprintCallable)
+	void WriteCheckpoint();
+
+	// [server] Loads a recent checkpoint from disk, if there is one, and applies it. Returns true if a checkpoint was applied.
+	UFUNCTION(BlueprintCallable)
+	bool RestoreCheckpoint();
+
+	// [server] Deletes the checkpoint, so it isn't picked up by the next match.
+	UFUNCTION(BlueprintCallable)
+	void ClearCheckpoint();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Seconds between checkpoint writes.
+	UPROPERTY(EditDefaultsOnly)
+	float CheckpointInterval = 10.f;
+
+	// Checkpoints older than this many seconds are assumed to belong to a previous match and are ignored.
+	UPROPERTY(EditDefaultsOnly)
+	float MaxCheckpointAge = 120.f;
+
+	UPROPERTY(EditDefaultsOnly)
+	bool bRestoreOnStartup = true;
+
+	// Runs a tick after BeginPlay, so the other game state components have initialised before they are restored.
+	void StartCheckpointing();
+
+	UFUNCTION()
+	void OnMatchStateChanged(EMatchState NewState);
+
+	void CaptureCheckpoint(FMatchCheckpoint& OutCheckpoint) const;
+	void ApplyCheckpoint(const FMatchCheckpoint& Checkpoint);
+	FString GetCheckpointPath() const;
+
+	// Identifies the deployment's match, so restarted workers only pick up checkpoints of their own match.
+	FString SessionId;
+
+	FTimerHandle CheckpointTimerHandle;
+	TFuture<void> PendingWrite;
+};
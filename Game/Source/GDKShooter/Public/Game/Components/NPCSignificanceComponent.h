@@ -0,0 +1,117 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TimerManager.h"
+#include "NPCSignificanceComponent.generated.h"
+
+class AGDKCharacter;
+
+UENUM(BlueprintType)
+enum class ENPCSignificance : uint8
+{
+	High,
+	Medium,
+	Low
+};
+
+USTRUCT(BlueprintType)
+struct FNPCSignificanceTier
+{
+	GENERATED_BODY()
+
+	// NPCs with a player or interest source closer than this are in the tier. Unused for the lowest tier.
+	UPROPERTY(EditAnywhere)
+	float MaxDistance = 0.f;
+
+	// Seconds between actor, movement and mesh ticks, 0 to tick every frame.
+	UPROPERTY(EditAnywhere)
+	float TickInterval = 0.f;
+
+	// Seconds between behavior tree ticks, 0 to tick every frame.
+	UPROPERTY(EditAnywhere)
+	float BehaviorTreeTickInterval = 0.f;
+
+	// Sight is the expensive sense, but NPCs with it off only notice players through damage or getting closer.
+	// On in every tier by default. Sight already spends its trace budget on the nearest listeners first.
+	UPROPERTY(EditAnywhere)
+	bool bSightEnabled = true;
+};
+
+// Ranks the NPCs this server is authoritative over by distance to the nearest player, and slows down ticking
+// for the ones no player is near. NPCs go back to full rate as soon as they take damage or a player approaches.
+// Toggle with GDK.NPCSignificance.Enabled to compare server frame time with and without it.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UNPCSignificanceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UNPCSignificanceComponent();
+
+	// [server] Characters register themselves on every server worker when they begin play, and unregister when they end play.
+	// Only characters this worker is authoritative over and which are possessed by an AI controller are throttled.
+	void RegisterCharacter(AGDKCharacter* Character);
+	void UnregisterCharacter(AGDKCharacter* Character);
+
+	// [server] Puts the character back to full rate for DamagePromotionTime seconds.
+	void NotifyDamaged(AGDKCharacter* Character);
+
+	// [server] Actors other than players that NPCs near to should run at full rate, e.g. objectives.
+	UFUNCTION(BlueprintCallable)
+	void AddInterestSource(AActor* Source);
+
+	UFUNCTION(BlueprintCallable)
+	void RemoveInterestSource(AActor* Source);
+
+	static UNPCSignificanceComponent* Get(const UObject* WorldContextObject);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void Evaluate();
+
+	ENPCSignificance Classify(const FVector& Location, ENPCSignificance CurrentSignificance, const TArray<FVector>& InterestLocations) const;
+
+	void ApplySignificance(AGDKCharacter* Character, ENPCSignificance Significance) const;
+
+	bool IsThrottleable(const AGDKCharacter* Character) const;
+
+	const FNPCSignificanceTier& GetTier(ENPCSignificance Significance) const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	FNPCSignificanceTier HighSignificance;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	FNPCSignificanceTier MediumSignificance;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	FNPCSignificanceTier LowSignificance;
+
+	// Distance in cm past a tier's MaxDistance before an NPC drops out of it, so NPCs on a boundary don't flip every evaluation.
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	float DemotionHysteresis = 500.f;
+
+	// Seconds an NPC stays at full rate after taking damage.
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	float DamagePromotionTime = 10.f;
+
+	// Seconds between evaluations.
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	float EvaluationInterval = 0.5f;
+
+	struct FNPCSignificanceState
+	{
+		ENPCSignificance Significance = ENPCSignificance::High;
+		float PromotedUntil = 0.f;
+	};
+
+	TMap<TWeakObjectPtr<AGDKCharacter>, FNPCSignificanceState> Characters;
+
+	TArray<TWeakObjectPtr<AActor>> InterestSources;
+
+	FTimerHandle EvaluationTimerHandle;
+};
@@ -0,0 +1,67 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GenericTeamAgentInterface.h"
+#include "TimerManager.h"
+#include "PerceptionRegistryComponent.generated.h"
+
+// Keeps perceivable actors in a coarse grid per team, so AI can find hostiles near them without walking every actor,
+// and so changing an actor's team is a move between buckets. Behavior trees query it with UBTTask_FindNearestHostile.
+// While a registry is on the game state, team changes no longer re-register actors with the engine perception system.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UPerceptionRegistryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPerceptionRegistryComponent();
+
+	// [server] Adds the actor with its current team, or updates its team if it is already registered.
+	void RegisterActor(AActor* Actor);
+	void UnregisterActor(AActor* Actor);
+
+	// [server] Moves a registered actor to the new team's bucket. Unregistered actors are ignored.
+	void UpdateTeam(AActor* Actor, FGenericTeamId NewTeamId);
+
+	// [server] Living hostiles to the querier within Radius, nearest first.
+	UFUNCTION(BlueprintCallable, Category = "Perception")
+	void FindHostilesNear(const AActor* Querier, float Radius, TArray<AActor*>& OutHostiles) const;
+
+	static UPerceptionRegistryComponent* Get(const UObject* WorldContextObject);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Moves actors whose position has changed cell, or whose team was changed on another worker.
+	void RefreshGrid();
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void AddToCell(const TWeakObjectPtr<AActor>& Actor, FGenericTeamId Team, const FIntPoint& Cell);
+	void RemoveFromCell(const TWeakObjectPtr<AActor>& Actor, FGenericTeamId Team, const FIntPoint& Cell);
+
+	// Size of a grid cell in cm, should be in the region of the typical scan radius.
+	UPROPERTY(EditDefaultsOnly)
+	float CellSize = 2500.f;
+
+	// Seconds between grid refreshes.
+	UPROPERTY(EditDefaultsOnly)
+	float RefreshInterval = 0.25f;
+
+	struct FRegisteredActor
+	{
+		FGenericTeamId Team;
+		FIntPoint Cell;
+	};
+
+	TMap<TWeakObjectPtr<AActor>, FRegisteredActor> RegisteredActors;
+
+	// Cells of actors, per team id.
+	TMap<uint8, TMap<FIntPoint, TArray<TWeakObjectPtr<AActor>>>> TeamGrids;
+
+	FTimerHandle RefreshTimerHandle;
+};
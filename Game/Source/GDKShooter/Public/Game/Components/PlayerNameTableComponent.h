@@ -0,0 +1,74 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/PlayerState.h"
+#include "PlayerNameTableComponent.generated.h"
+
+// A single entry in the match-wide name table
+USTRUCT(BlueprintType)
+struct FPlayerNameEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PlayerId;
+
+	UPROPERTY(BlueprintReadOnly)
+	FString PlayerName;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPlayerNamesChangedEvent);
+
+// Replicates each player's name once per match, so that scores and kill-feed events only need to carry the player id.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UPlayerNameTableComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPlayerNameTableComponent();
+
+	// [server] Adds the player to the table, or updates their name if they are already in it.
+	UFUNCTION(BlueprintCallable)
+	void RegisterPlayer(APlayerState* PlayerState);
+
+	UFUNCTION(BlueprintPure)
+	FString GetPlayerName(int32 PlayerId) const;
+
+	// Returns nullptr if the id is unknown, avoiding a copy of the name.
+	const FString* FindPlayerName(int32 PlayerId) const;
+
+	// Looks up a name through the table on the world's game state, falling back to the player's APlayerState when the
+	// game state has no table or the table doesn't know the player yet. Returns an empty string if neither has it.
+	static FString ResolvePlayerName(const UObject* WorldContextObject, int32 PlayerId);
+
+	// The player's APlayerState on the world's game state, nullptr if there is none.
+	static const APlayerState* FindPlayerState(const UObject* WorldContextObject, int32 PlayerId);
+
+	static UPlayerNameTableComponent* Get(const UObject* WorldContextObject);
+
+	const TArray<FPlayerNameEntry>& GetEntries() const { return Names; }
+
+	// [server] Replaces the whole table, e.g. when restoring from a checkpoint.
+	void RestoreEntries(const TArray<FPlayerNameEntry>& Entries);
+
+	UPROPERTY(BlueprintAssignable)
+	FPlayerNamesChangedEvent NamesChanged;
+
+protected:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	UFUNCTION()
+	void OnRep_Names();
+
+	void RebuildIndex();
+
+	UPROPERTY(ReplicatedUsing = OnRep_Names)
+	TArray<FPlayerNameEntry> Names;
+
+	// A map from player id to index in Names
+	TMap<int32, int32> NameIndexMap;
+};
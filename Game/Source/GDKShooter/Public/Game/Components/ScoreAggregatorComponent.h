@@ -0,0 +1,122 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/PlayerState.h"
+#include "TimerManager.h"
+#include "ScoreAggregatorComponent.generated.h"
+
+// Kills and deaths accumulated for one player since the last flush
+USTRUCT()
+struct FPlayerScoreDelta
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 PlayerId = -1;
+
+	UPROPERTY()
+	int32 Kills = 0;
+
+	UPROPERTY()
+	int32 Deaths = 0;
+};
+
+// All of the score changes a worker saw during one flush interval
+USTRUCT()
+struct FScoreDeltaBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString WorkerId;
+
+	// Identifies a run of the sending worker, so a restarted worker's sequence numbers aren't mistaken for duplicates.
+	UPROPERTY()
+	int64 WorkerEpoch = 0;
+
+	UPROPERTY()
+	int32 Sequence = 0;
+
+	UPROPERTY()
+	TArray<FPlayerScoreDelta> Deltas;
+};
+
+// The batches the authoritative worker has applied from one run of a sending worker
+USTRUCT()
+struct FAppliedScoreBatches
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString WorkerId;
+
+	UPROPERTY()
+	int64 WorkerEpoch = 0;
+
+	// Every batch up to and including this sequence has been applied.
+	UPROPERTY()
+	int32 ContiguousSequence = 0;
+
+	// Applied batches after a gap, in ascending order. Emptied as the gap fills.
+	UPROPERTY()
+	TArray<int32> AppliedAfterGap;
+};
+
+// Collects kills on every worker and sends them to the worker authoritative over the scores in one batch per interval.
+// Binds to the UScorePublisher's KillEvent, so it replaces binding that event directly to the score components.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UScoreAggregatorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UScoreAggregatorComponent();
+
+	// [server] Records a kill on this worker, to be sent with the next flush.
+	UFUNCTION(BlueprintCallable)
+	void RecordKill(APlayerState* KillerState, APlayerState* VictimState);
+
+	// [server] Sends everything recorded so far.
+	UFUNCTION(BlueprintCallable)
+	void Flush();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION(CrossServer, Reliable)
+	void ApplyScoreDeltas(const FScoreDeltaBatch& Batch);
+
+	void ApplyDeltasToScores(const TArray<FPlayerScoreDelta>& Deltas);
+
+	// [authoritative] Records the batch as applied, returns false if it already was.
+	bool MarkBatchApplied(const FScoreDeltaBatch& Batch);
+
+	FPlayerScoreDelta& FindOrAddDelta(int32 PlayerId);
+
+	// Seconds between flushes.
+	UPROPERTY(EditDefaultsOnly)
+	float FlushInterval = 1.f;
+
+	// Batches a sender can get ahead of a missing one before the missing batch is given up on.
+	UPROPERTY(EditDefaultsOnly)
+	int32 MaxBatchesAfterGap = 64;
+
+	TArray<FPlayerScoreDelta> PendingDeltas;
+	// A map from player id to index in PendingDeltas
+	TMap<int32, int32> PendingDeltaIndex;
+
+	FString LocalWorkerId;
+	int64 LocalWorkerEpoch;
+	int32 NextSequence;
+
+	// [authoritative] What has been applied from each run of each sending worker. Handed over with authority, so a
+	// new authoritative worker doesn't apply redelivered batches again.
+	UPROPERTY(Handover)
+	TArray<FAppliedScoreBatches> AppliedBatches;
+
+	FTimerHandle FlushTimerHandle;
+};
@@ -0,0 +1,73 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Controller.h"
+#include "Metrics/GDKHistogram.h"
+#include "SpawnLatencyTrackerComponent.generated.h"
+
+// Stages of a spawn, in the order they happen.
+UENUM(BlueprintType)
+enum class ESpawnStage : uint8
+{
+	// [server] ServerTryJoinGame or ServerRespawnCharacter received.
+	Requested,
+	// [server] Request left the spawn queue and was published to the spawner.
+	Published,
+	// [server] Pawn created, or taken from the pool.
+	PawnSpawned,
+	// [server] Controller possessed the pawn.
+	Possessed,
+	// [server] Starter holdables spawned, or handed the player's meta data.
+	Equipped,
+	// [client] Pawn arrived and was set on the owning client's controller.
+	ClientPossessed,
+	Count UMETA(Hidden)
+};
+
+// Times each stage of a spawn, correlated by controller, and keeps a latency histogram per stage.
+// Server stages are timed from the previous stage. ClientPossessed is timed from the request, using server world time.
+// Use GDK.SpawnLatency.Stats to log the histograms and GDK.SpawnLatency.DumpCsv to write them to Saved/Profiling.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API USpawnLatencyTrackerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USpawnLatencyTrackerComponent();
+
+	// Records a stage for the controller's current spawn on the tracker on the world's game state, if there is one.
+	static void RecordStage(const UObject* WorldContextObject, const AController* Controller, ESpawnStage Stage);
+
+	// [client] Records the time from the spawn request to the pawn arriving.
+	static void RecordClientLatency(const UObject* WorldContextObject, double Seconds);
+
+	static USpawnLatencyTrackerComponent* Get(const UObject* WorldContextObject);
+
+	void LogStats() const;
+
+	// Writes one row per stage and returns the path written, or an empty string on failure.
+	FString DumpCsv() const;
+
+	void Reset();
+
+protected:
+	void Record(const AController* Controller, ESpawnStage Stage);
+
+	struct FSpawnTimeline
+	{
+		double StageTimes[(int32)ESpawnStage::Count];
+		int32 LastStage;
+	};
+
+	// Spawns in progress. Entries are replaced when the controller next requests a spawn.
+	TMap<TWeakObjectPtr<const AController>, FSpawnTimeline> Timelines;
+
+	// Milliseconds from the previous stage, indexed by ESpawnStage.
+	TArray<FGDKHistogram> StageHistograms;
+
+	// Milliseconds from Requested to Equipped, on the server.
+	FGDKHistogram ServerTotalHistogram;
+};
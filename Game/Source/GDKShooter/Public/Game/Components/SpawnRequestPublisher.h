@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Metrics/GDKHistogram.h"
 #include "SpawnRequestPublisher.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSpawnRequest, APlayerController*, Controller);
@@ -16,11 +17,60 @@ class GDKSHOOTER_API USpawnRequestPublisher : public UActorComponent
 public:
 	USpawnRequestPublisher();
 
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 	UPROPERTY(BlueprintAssignable)
 	FSpawnRequest OnSpawnRequest;
 
-	void RequestSpawn(APlayerController* Controller) { OnSpawnRequest.Broadcast(Controller); }
-	
+	// [server] Publishes the request, or queues it to be published within the per frame budget when bUseSpawnQueue is set.
+	void RequestSpawn(APlayerController* Controller);
+
 	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly)
 	bool bAutoConnect;
+
+	UFUNCTION(BlueprintPure)
+	int32 GetQueueDepth() const { return SpawnQueue.Num(); }
+
+	const FGDKHistogram& GetQueueDepthHistogram() const { return QueueDepthHistogram; }
+	const FGDKHistogram& GetWaitTimeHistogram() const { return WaitTimeHistogram; }
+
+	// Logs the queue histograms, also available as the GDK.SpawnQueue.Stats console command.
+	void LogQueueStats() const;
+
+protected:
+	struct FQueuedSpawnRequest
+	{
+		TWeakObjectPtr<APlayerController> Controller;
+		double EnqueueTime;
+	};
+
+	// Spread spawn requests over several frames, so a lobby full of players joining at once doesn't cause one huge hitch.
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Queue")
+	bool bUseSpawnQueue = true;
+
+	// Stop publishing requests for the frame once this many milliseconds have been spent on them.
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Queue")
+	float FrameTimeBudgetMs = 4.f;
+
+	// Stop publishing requests for the frame once this many entities are estimated to have been created.
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Queue")
+	int32 FrameEntityBudget = 20;
+
+	// Estimated entities created per spawn, the pawn plus its starter holdables.
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Queue")
+	int32 EstimatedEntitiesPerSpawn = 5;
+
+	// Requests that have waited longer than this many seconds are published regardless of the budget.
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn Queue")
+	float MaxQueueLatency = 2.f;
+
+	void PublishRequest(APlayerController* Controller);
+
+	// First in, first out. A controller can only be queued once, so spamming respawn doesn't push others back.
+	TArray<FQueuedSpawnRequest> SpawnQueue;
+	TSet<TWeakObjectPtr<APlayerController>> QueuedControllers;
+
+	// Queue depth sampled each frame the queue is not empty, and wait time in milliseconds.
+	FGDKHistogram QueueDepthHistogram;
+	FGDKHistogram WaitTimeHistogram;
 };
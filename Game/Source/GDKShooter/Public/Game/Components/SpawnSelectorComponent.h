@@ -0,0 +1,86 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/PlayerStart.h"
+#include "GenericTeamAgentInterface.h"
+#include "TimerManager.h"
+#include "SpawnSelectorComponent.generated.h"
+
+class AGDKCharacter;
+
+// Picks player starts away from enemies. Living characters are kept in a coarse grid which is refreshed
+// on a timer, so each query only looks at the cells around a bounded number of candidate starts.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API USpawnSelectorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USpawnSelectorComponent();
+
+	// [server] Returns the safest start for the controller, or nullptr if the selector has no starts to pick from.
+	UFUNCTION(BlueprintCallable)
+	APlayerStart* SelectSpawnPoint(AController* Controller);
+
+	// [server] Characters register themselves on every server worker when they begin play, and unregister when they end play.
+	void RegisterCharacter(AGDKCharacter* Character);
+	void UnregisterCharacter(AGDKCharacter* Character);
+
+	static USpawnSelectorComponent* Get(const UObject* WorldContextObject);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Moves characters whose position has changed cell, and takes dead characters out of the grid.
+	void RefreshGrid();
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void RemoveFromCell(AGDKCharacter* Character, const FIntPoint& Cell);
+
+	// Sums the proximity of every enemy within DangerRadius, and collects them for line of sight checks.
+	float ScoreProximity(const FVector& Location, const FGenericTeamId& Team, TArray<AGDKCharacter*>& OutNearbyEnemies) const;
+
+	bool IsEnemy(const AGDKCharacter* Character, const FGenericTeamId& Team) const;
+
+	// Size of a grid cell in cm, should be in the region of DangerRadius.
+	UPROPERTY(EditDefaultsOnly)
+	float CellSize = 2500.f;
+
+	// Enemies further away than this don't affect a start.
+	UPROPERTY(EditDefaultsOnly)
+	float DangerRadius = 3000.f;
+
+	// Added to a start's score if any nearby enemy can see it.
+	UPROPERTY(EditDefaultsOnly)
+	float LineOfSightPenalty = 2.f;
+
+	// The most starts scored per query.
+	UPROPERTY(EditDefaultsOnly)
+	int32 MaxCandidates = 16;
+
+	// The most line traces made per query.
+	UPROPERTY(EditDefaultsOnly)
+	int32 MaxLineOfSightChecks = 8;
+
+	// Seconds between grid refreshes.
+	UPROPERTY(EditDefaultsOnly)
+	float RefreshInterval = 0.25f;
+
+	UPROPERTY(EditDefaultsOnly)
+	TEnumAsByte<ECollisionChannel> LineOfSightCollisionChannel = ECC_Visibility;
+
+	UPROPERTY()
+	TArray<APlayerStart*> PlayerStarts;
+
+	// Cell each registered character is in, or InvalidCell if they are dead.
+	TMap<TWeakObjectPtr<AGDKCharacter>, FIntPoint> CharacterCells;
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AGDKCharacter>>> Grid;
+
+	bool bHasPlayerStartPIE;
+
+	FTimerHandle RefreshTimerHandle;
+};
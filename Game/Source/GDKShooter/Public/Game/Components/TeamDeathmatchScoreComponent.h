@@ -63,12 +63,22 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FTeamScoreChangeEvent ScoreEvent;
 
+	// [server] Adds to a player's kills and deaths, used for batched updates from other workers.
+	void ApplyScoreDelta(int32 PlayerId, int32 Kills, int32 Deaths);
+
+	// [server] Replaces all team and player scores, e.g. when restoring from a checkpoint.
+	void RestoreTeamScores(const TArray<FTeamScore>& Scores);
+
 protected:
+	virtual void BeginPlay() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	UFUNCTION()
 	void OnRep_TeamScores();
 
+	UFUNCTION()
+	void OnPlayerNamesChanged();
+
 	UPROPERTY(ReplicatedUsing = OnRep_TeamScores)
 	TArray<FTeamScore> TeamScoreArray;
 
@@ -77,4 +87,8 @@ protected:
 
 	UPROPERTY()
 	TMap<int32, int32> PlayerScoreMap;
+
+	// A map from player id to team id, for updates that only carry the player id
+	UPROPERTY()
+	TMap<int32, uint8> PlayerTeamMap;
 };
@@ -26,6 +26,12 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void PlayerDisconnected(APlayerController* Controller);
 
+	// Fills OutPlayerTeams with the team of every spawned player, keyed by PlayerId.
+	void GetPlayerTeams(TMap<int32, int32>& OutPlayerTeams) const;
+
+	// [server] Players in this map keep their team when they next request a spawn, e.g. after a worker restart.
+	void RestorePlayerTeams(const TMap<int32, int32>& PlayerTeams);
+
 	// When Enabled, will spawn players at players starts that have a UTeamComponent which matches the players team.
 	UPROPERTY(EditDefaultsOnly)
 	bool bUseTeamPlayerStarts;
@@ -34,17 +40,33 @@ public:
 	UPROPERTY(EditDefaultsOnly)
 	bool bShufflePlayerStarts;
 
+	// When Enabled, prefers player starts this worker is authoritative over, so new pawns aren't immediately handed over to another worker.
+	UPROPERTY(EditDefaultsOnly)
+	bool bPreferLocalPlayerStarts = true;
+
+	// Number of spawns moved to a local player start instead of the next start in order, which would have caused a handover.
+	UFUNCTION(BlueprintPure)
+	int32 GetHandoversAvoided() const { return HandoversAvoided; }
+
 protected:
 	int32 GetSmallestTeam();
-	void ShufflePlayerStartArray(TArray<class APlayerStart*> Array);
+	void ShufflePlayerStartArray(TArray<class APlayerStart*>& Array);
 
 	class APlayerStart* GetNextTeamPlayerStart(FGenericTeamId Team);
 	class APlayerStart* GetNextPlayerStart();
 
+	// Round robins through Starts from NextIndex, skipping ahead to a start owned by this worker when bPreferLocalPlayerStarts is set.
+	class APlayerStart* PickPlayerStart(const TArray<class APlayerStart*>& Starts, int32& NextIndex);
+	bool IsPlayerStartLocal(const class APlayerStart* PlayerStart) const;
+
 	TArray<class APlayerStart*> PlayerStarts;
-	TArray<class APlayerStart*> TeamPlayerStarts;
+	// Player starts with a UTeamComponent, bucketed by their team when SetTeams is called.
+	TMap<FGenericTeamId, TArray<class APlayerStart*>> TeamPlayerStarts;
 	TMap<int32, int32> TeamAssignments;
 	TMap<APlayerController*, int32> SpawnedPlayers;
+	// Team assignments restored from a checkpoint, keyed by PlayerId, waiting for the player to request a spawn.
+	TMap<int32, int32> RestoredPlayerTeams;
 	TMap<FGenericTeamId, int32> NextTeamPlayerStart;
 	int32 NextPlayerStart;
+	int32 HandoversAvoided;
 };
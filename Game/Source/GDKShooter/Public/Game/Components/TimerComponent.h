@@ -11,6 +11,29 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTimerEvent, int, CurrentTimer);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FTimerFinishedEvent);
 
+// Everything clients need to count a timer down themselves, so it only replicates when the timer is started, stopped or set.
+USTRUCT()
+struct FReplicatedTimerState
+{
+	GENERATED_BODY()
+
+	// Server world time the timer was last started or set while running.
+	UPROPERTY()
+	float StartTime = 0.f;
+
+	// Seconds left at StartTime, or while stopped.
+	UPROPERTY()
+	int32 Duration = 0;
+
+	UPROPERTY()
+	bool bIsRunning = false;
+
+	UPROPERTY()
+	bool bHasFinished = false;
+};
+
+// A countdown in whole seconds. Clients work out the time left from the server's world time, and broadcast OnTimer
+// locally each time it changes, while the server only wakes up once, when the timer runs out.
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class GDKSHOOTER_API UTimerComponent : public UActorComponent
 {
@@ -37,11 +60,19 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FTimerFinishedEvent OnTimerFinished;
 
+	// Seconds left, counted down from when the timer was started.
 	UFUNCTION(BlueprintPure)
-	int32 GetTimer() { return TimeLeft; }
+	int32 GetTimer() const;
+
+	bool IsTimerRunning() const { return TimerState.bIsRunning; }
+	bool HasTimerFinished() const { return TimerState.bHasFinished; }
+
+	// [server] Puts the timer back into a previously checkpointed state.
+	void RestoreTimer(int32 NewTimeLeft, bool bRunning, bool bFinished);
 
 protected:
-	void BeginPlay();
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditDefaultsOnly)
 	bool bAutoStart = false;
@@ -49,23 +80,29 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	int32 DefaultTimerDuration = 7200;
 
-	UPROPERTY(Replicated, BlueprintReadOnly)
-	bool bIsTimerRunning = false;
+	UPROPERTY(ReplicatedUsing = OnRep_TimerState)
+	FReplicatedTimerState TimerState;
 
-	UPROPERTY(ReplicatedUsing = OnRep_Timer, BlueprintReadOnly)
-	int32 TimeLeft;
+	// Server world time on this machine, which clients keep in sync with the server's.
+	float GetServerTime() const;
 
-	UPROPERTY(ReplicatedUsing = OnRep_TimerFinished, BlueprintReadOnly)
-	bool bHasTimerFinished = false;
+	// [server] Arms FinishTimerHandle for when the running timer reaches zero.
+	void ScheduleFinish();
 
-	UFUNCTION()
-	void DecrementTimer();
+	// [server] The timer has reached zero.
+	void FinishTimer();
 
-	UFUNCTION()
-	void OnRep_Timer();
+	// Broadcasts OnTimer when the time left has changed since the last broadcast.
+	void UpdateDisplayedTime();
 
 	UFUNCTION()
-	void OnRep_TimerFinished();
+	void OnRep_TimerState();
+
+	FTimerHandle FinishTimerHandle;
+
+	// Not on dedicated servers: wakes up once a second while running, to broadcast OnTimer for the UI.
+	FTimerHandle DisplayTimerHandle;
 
-	FTimerHandle TimerHandle;
+	int32 LastBroadcastTime = INDEX_NONE;
+	bool bHadFinished = false;
 };
@@ -0,0 +1,37 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "GDKNetDriver.generated.h"
+
+// The project's net driver, set as the GameNetDriver in DefaultEngine.ini.
+// Every RPC a worker sends goes through ProcessRemoteFunction, so this is the one place they are counted.
+UCLASS()
+class GDKSHOOTER_API UGDKNetDriver : public USpatialNetDriver
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject = nullptr) override;
+
+	// Counts the RPCs sent per function while enabled. Off by default.
+	void SetCountRpcs(bool bEnabled);
+
+	// Moves the counts since the last call into OutCounts, adding to what is already there.
+	void ConsumeRpcCounts(TMap<FName, int32>& OutCounts);
+
+	// Adds up the parameter payload of the RPCs sent until EndMeasuringRpcBytes, serialized as they are sent.
+	void BeginMeasuringRpcBytes();
+	int32 EndMeasuringRpcBytes();
+
+private:
+	int32 GetSerializedParameterBytes(UFunction* Function, void* Parameters);
+
+	TMap<FName, int32> RpcCounts;
+	bool bCountRpcs = false;
+
+	int32 MeasuredRpcBytes = 0;
+	bool bMeasureRpcBytes = false;
+};
@@ -0,0 +1,62 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GDKStats.h"
+
+// Inclusive game thread time and call counts per instrumented function, gathered while enabled, so runs of two builds
+// can be compared outside the stats system. Instrument a scope with GDK_SCOPE_CYCLE_COUNTER in place of SCOPE_CYCLE_COUNTER,
+// timings are keyed by the stat's name.
+class GDKSHOOTER_API FGDKFunctionTimings
+{
+public:
+	static void SetEnabled(bool bEnabled) { bIsEnabled = bEnabled; }
+	static bool IsEnabled() { return bIsEnabled; }
+
+	static void Add(FName Name, uint64 Cycles);
+	static void Reset();
+
+	// Name,Calls,TotalMs,MsPerCall, most expensive first.
+	static FString ToCsv();
+
+private:
+	struct FTiming
+	{
+		int64 Calls = 0;
+		uint64 Cycles = 0;
+	};
+
+	static TMap<FName, FTiming> Timings;
+	static bool bIsEnabled;
+};
+
+class FGDKScopedFunctionTiming
+{
+public:
+	FGDKScopedFunctionTiming(FName InName)
+		: Name(InName)
+		, bEnabled(FGDKFunctionTimings::IsEnabled())
+		, StartCycles(bEnabled ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FGDKScopedFunctionTiming()
+	{
+		if (bEnabled)
+		{
+			FGDKFunctionTimings::Add(Name, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	FName Name;
+	bool bEnabled;
+	uint64 StartCycles;
+};
+
+// The name is made once per call site rather than on every call.
+#define GDK_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	static const FName GDKFunctionTimingName_##Stat(TEXT(#Stat)); \
+	FGDKScopedFunctionTiming ANONYMOUS_VARIABLE(GDKFunctionTiming)(GDKFunctionTimingName_##Stat)
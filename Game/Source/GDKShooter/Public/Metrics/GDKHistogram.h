@@ -0,0 +1,44 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Fixed size histogram for latency style measurements. Bucket bounds grow geometrically from MinValue,
+// so a few dozen buckets cover everything from sub-millisecond to minutes without allocating per sample.
+class GDKSHOOTER_API FGDKHistogram
+{
+public:
+	FGDKHistogram(double InMinValue = 0.1, double InGrowth = 1.5, int32 InNumBuckets = 40);
+
+	void Add(double Value);
+	void Reset();
+
+	int64 GetCount() const { return Count; }
+	double GetMin() const { return Count > 0 ? Min : 0.0; }
+	double GetMax() const { return Count > 0 ? Max : 0.0; }
+	double GetMean() const { return Count > 0 ? Sum / Count : 0.0; }
+
+	// Upper bound of the bucket holding the given percentile (0-100), clamped to the largest value seen.
+	double GetPercentile(double Percentile) const;
+
+	// e.g. "n=12 mean=3.20 p50=2.53 p90=5.70 p99=8.54 max=9.10"
+	FString ToString() const;
+
+	static FString GetCsvHeader();
+	// Name,Count,Mean,Min,P50,P90,P99,Max
+	FString ToCsvRow(const FString& Name) const;
+
+private:
+	int32 GetBucketIndex(double Value) const;
+	double GetBucketUpperBound(int32 Index) const;
+
+	double MinValue;
+	double Growth;
+	TArray<int64> Buckets;
+
+	int64 Count;
+	double Sum;
+	double Min;
+	double Max;
+};
@@ -0,0 +1,151 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Game/Components/MatchStateComponent.h"
+#include "TimerManager.h"
+#include "PhaseManagerComponent.generated.h"
+
+class AGDKCharacter;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPhaseChangedEvent, int32, Phase);
+
+USTRUCT(BlueprintType)
+struct FPhaseEntry
+{
+	GENERATED_BODY()
+
+	// Seconds the phase lasts, zero or less for a phase that never ends.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float Duration = 60.f;
+
+	// Shown before and after the time left in the phase.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FText PreTimerText;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FText PostTimerText;
+};
+
+// The whole schedule, replicated once when phases start. Every machine works out the current phase from it.
+USTRUCT()
+struct FPhaseSchedule
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FPhaseEntry> Phases;
+
+	// Server world time phase 0 started, negative before phases have started.
+	UPROPERTY()
+	float StartTime = -1.f;
+};
+
+// Steps a map through its phases, to be added to the GameState. The server replicates the schedule once, then the
+// server and every client advance through it on their own from the synchronised server world time.
+// IPhaseActivated actors register for the phase they care about, and only that phase's listeners are called when it
+// starts. Listeners registering after their phase has started, e.g. on a client joining late, are snapped to it.
+// Meant to take over from the Blueprint PhaseBasedMapComponent, so don't add both to a GameState: listeners would be
+// called by each. Registering without this component on the GameState logs a warning and does nothing.
+// The migration isn't finished: no GameState Blueprint has this component yet, and BP_Door and PhasedFloorSection
+// still wait to be found by PhaseBasedMapComponent rather than calling RegisterPhaseListener from BeginPlay.
+// APhasedPainCausingVolume and APhasedSafeZone register already.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GDKSHOOTER_API UPhaseManagerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPhaseManagerComponent();
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	static UPhaseManagerComponent* Get(const UObject* WorldContextObject);
+
+	// Calls Listener's IPhaseActivated functions when Phase starts. Listeners may register for several phases.
+	UFUNCTION(BlueprintCallable, Category = "Phases", meta = (DefaultToSelf = "Listener"))
+	static void RegisterPhaseListener(UObject* Listener, int32 Phase);
+
+	UFUNCTION(BlueprintCallable, Category = "Phases", meta = (DefaultToSelf = "Listener"))
+	static void UnregisterPhaseListener(UObject* Listener);
+
+	// [server] Characters register when they begin play and unregister when they end play, so phased actors such as
+	// APhasedSafeZone can act on them without iterating the world.
+	void RegisterCharacter(AGDKCharacter* Character);
+	void UnregisterCharacter(AGDKCharacter* Character);
+
+	// [server] Characters this worker can see, whether or not it has authority over them.
+	const TArray<AGDKCharacter*>& GetCharacters() const { return Characters; }
+
+	// [server] Starts phase 0 now.
+	UFUNCTION(BlueprintCallable, Category = "Phases")
+	void StartPhases();
+
+	// INDEX_NONE before phases start, the number of phases once the last has ended.
+	UFUNCTION(BlueprintPure, Category = "Phases")
+	int32 GetCurrentPhase() const { return CurrentPhase; }
+
+	UFUNCTION(BlueprintPure, Category = "Phases")
+	bool HasStarted() const { return Schedule.StartTime >= 0.f; }
+
+	UFUNCTION(BlueprintPure, Category = "Phases")
+	bool IsInFinalPhase() const { return CurrentPhase == Schedule.Phases.Num() - 1; }
+
+	UFUNCTION(BlueprintPure, Category = "Phases")
+	bool HasFinished() const { return HasStarted() && CurrentPhase >= Schedule.Phases.Num(); }
+
+	// Seconds until the current phase ends, zero if it never does.
+	UFUNCTION(BlueprintPure, Category = "Phases")
+	float GetPhaseTimeRemaining() const;
+
+	// The current phase's entry, false when not in a phase.
+	UFUNCTION(BlueprintPure, Category = "Phases")
+	bool GetCurrentPhaseEntry(FPhaseEntry& OutEntry) const;
+
+	// Server world time the given phase starts, the largest float if it is never reached.
+	float GetPhaseStartTime(int32 Phase) const { return Phase > 0 ? GetPhaseEndTime(Phase - 1) : Schedule.StartTime; }
+
+	// Server world time the given phase ends, the largest float if it never does.
+	float GetPhaseEndTime(int32 Phase) const;
+
+	UPROPERTY(BlueprintAssignable)
+	FPhaseChangedEvent PhaseChanged;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION()
+	void OnMatchStateChanged(EMatchState NewState);
+
+	UFUNCTION()
+	void OnRep_Schedule();
+
+	// Catches up with the schedule, calling the listeners of every phase that has started since, and waits for the next.
+	void UpdatePhase();
+
+	void NotifyListeners(int32 Phase, bool bSnap);
+
+	float GetServerTime() const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Phases")
+	TArray<FPhaseEntry> DefaultPhases;
+
+	// Starts the phases when the UMatchStateComponent moves to InGame.
+	UPROPERTY(EditDefaultsOnly, Category = "Phases")
+	bool bStartWithMatch = true;
+
+	UPROPERTY(ReplicatedUsing = OnRep_Schedule)
+	FPhaseSchedule Schedule;
+
+	int32 CurrentPhase = INDEX_NONE;
+
+	// Listeners by the phase they registered for.
+	TMap<int32, TArray<TWeakObjectPtr<UObject>>> Listeners;
+
+	UPROPERTY()
+	TArray<AGDKCharacter*> Characters;
+
+	FTimerHandle PhaseTimerHandle;
+};
@@ -6,10 +6,12 @@
 #include "Engine/PostProcessVolume.h"
 #include "GameFramework/PainCausingVolume.h"
 #include "IPhaseActivated.h"
+#include "PhaseManagerComponent.h"
 #include "PhasedPainCausingVolume.generated.h"
 
 /**
- * 
+ * A fixed pain volume that switches on in a phase, relying on overlaps with each pawn.
+ * For moving or shrinking areas use APhasedSafeZone, which needs no overlap tests.
  */
 UCLASS()
 class GDKSHOOTER_API APhasedPainCausingVolume : public APainCausingVolume, public IPhaseActivated
@@ -24,12 +26,23 @@ public:
 
 	void BeginPlay() override
 	{
+		Super::BeginPlay();
+
 		if (PostProcessVolume)
 		{
 			PostProcessVolume->bEnabled = false;
 			PostProcessVolume->SetActorLocation(GetActorLocation());
 			PostProcessVolume->SetActorScale3D(GetActorScale3D() - FVector(1, 1, 0));
 		}
+
+		UPhaseManagerComponent::RegisterPhaseListener(this, ActivatesInPhase);
+	}
+
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override
+	{
+		UPhaseManagerComponent::UnregisterPhaseListener(this);
+
+		Super::EndPlay(EndPlayReason);
 	}
 
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly)
@@ -0,0 +1,136 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/DamageType.h"
+#include "IPhaseActivated.h"
+#include "PhasedSafeZone.generated.h"
+
+class AGDKCharacter;
+
+UENUM(BlueprintType)
+enum class ESafeZoneShape : uint8
+{
+	Circle,
+	Box
+};
+
+// The safe area a zone shrinks to once a phase starts.
+USTRUCT(BlueprintType)
+struct FSafeZonePhase
+{
+	GENERATED_BODY()
+
+	// Map phase this zone phase starts in.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	int32 StartsInPhase = 0;
+
+	// Centre of the safe area at the end of the shrink, in world space.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FVector2D Center = FVector2D::ZeroVector;
+
+	// Radius in X for a circle, half size for a box, at the end of the shrink.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FVector2D Extent = FVector2D(10000.f, 10000.f);
+
+	// Seconds to move from the previous safe area to this one.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float ShrinkDuration = 60.f;
+
+	// Damage to pawns outside the safe area.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float DamagePerSecond = 5.f;
+};
+
+// The zone phase in progress, which is all that's needed to work out the safe area at any time.
+struct FSafeZoneProgress
+{
+	int32 PhaseIndex = INDEX_NONE;
+
+	// Server world time the shrink started.
+	float StartTime = 0.f;
+};
+
+/**
+ * A safe area described analytically by a shape and a shrink schedule, which damages pawns outside it.
+ * Replaces overlap tracking: every DamageInterval, the server gathers the positions of the characters registered with
+ * the UPhaseManagerComponent it has authority over, works out each one's signed distance to the safe area in a single
+ * pass, then damages those outside it together through their health components.
+ * Going straight to UHealthComponent::TakeDamage skips AActor::TakeDamage, so OnTakeAnyDamage and ReceiveAnyDamage
+ * aren't called for zone damage. Bind to the health component's events instead.
+ * Nothing replicates per phase. Every machine picks the zone phase from the map phase it is told about, and takes the
+ * shrink's start time from the UPhaseManagerComponent's schedule, so servers and clients agree on the safe area.
+ */
+UCLASS(SpatialType)
+class GDKSHOOTER_API APhasedSafeZone : public AActor, public IPhaseActivated
+{
+	GENERATED_BODY()
+
+public:
+	APhasedSafeZone();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual void SnapToPhase_Implementation(int32 Phase) override;
+	virtual void ProgressToPhase_Implementation(int32 Phase) override;
+
+	// Safe area now, false before the first zone phase starts.
+	UFUNCTION(BlueprintPure, Category = "Safe Zone")
+	bool GetSafeArea(FVector2D& OutCenter, FVector2D& OutExtent) const;
+
+	// Distance outside the safe area, negative inside. Zero before the first zone phase starts.
+	UFUNCTION(BlueprintPure, Category = "Safe Zone")
+	float GetSignedDistance(const FVector& Location) const;
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Safe Zone")
+	void OnZonePhaseStarted(int32 PhaseIndex);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Starts the latest zone phase due by the map phase. Without a phase manager to take the start time from, snapping
+	// starts it already shrunk, e.g. for late joiners.
+	void StartZonePhaseFor(int32 Phase, bool bSnap);
+
+	bool GetSafeAreaAt(float Time, FVector2D& OutCenter, FVector2D& OutExtent) const;
+
+	// [server] Damages every registered character outside the safe area.
+	void ApplyZoneDamage();
+
+	float GetServerTime() const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Safe Zone")
+	ESafeZoneShape Shape;
+
+	// Safe area before the first zone phase, centred on the actor.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Safe Zone")
+	FVector2D InitialExtent;
+
+	// In the order they start.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Safe Zone")
+	TArray<FSafeZonePhase> Phases;
+
+	// Seconds between damage passes.
+	UPROPERTY(EditAnywhere, Category = "Safe Zone")
+	float DamageInterval;
+
+	UPROPERTY(EditAnywhere, Category = "Safe Zone")
+	TSubclassOf<UDamageType> DamageType;
+
+	// [client] Scaled to the safe area every frame. Sized for the engine's basic shapes, 100 units across.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Safe Zone")
+	class UStaticMeshComponent* ZoneMesh;
+
+	FSafeZoneProgress Progress;
+
+	FTimerHandle DamageTimerHandle;
+
+	// Scratch space for the damage pass, kept to avoid reallocating every interval.
+	TArray<AGDKCharacter*> CharacterScratch;
+	TArray<float> XScratch;
+	TArray<float> YScratch;
+	TArray<float> DistanceScratch;
+};
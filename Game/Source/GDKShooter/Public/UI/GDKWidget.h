@@ -11,6 +11,9 @@
 #include "Game/Components/TeamDeathmatchScoreComponent.h"
 #include "GDKWidget.generated.h"
 
+class UListView;
+class UScoreboardViewModel;
+
 /**
  * UMG Widget exposing multiple Events relating to Pawn, Player and Game state.
  */
@@ -59,14 +62,31 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "GDK")
 	void OnAimingUpdated(bool bIsAiming);
 
-	// Called when the game state RepNotifies a new scoreboard
+	// Called when the game state RepNotifies a new scoreboard, unless ScoreboardList is bound
 	UFUNCTION(BlueprintImplementableEvent, Category = "GDK")
 	void OnPlayerScoresUpdated(const TArray<FPlayerScore>& Scores);
 
-	// Called when the game state RepNotifies a new team scoreboard
+	// Called when the game state RepNotifies a new team scoreboard, unless ScoreboardList is bound
 	UFUNCTION(BlueprintImplementableEvent, Category = "GDK")
 	void OnTeamScoresUpdated(const TArray<FTeamScore>& Scores);
 
+	UFUNCTION()
+	void OnPlayerScoresChanged(const TArray<FPlayerScore>& Scores);
+
+	UFUNCTION()
+	void OnTeamScoresChanged(const TArray<FTeamScore>& Scores);
+
+	UFUNCTION()
+	void OnScoreboardRowsChanged();
+
+	// Rows of the scoreboard, kept up to date with only the changes between score updates
+	UPROPERTY(BlueprintReadOnly, Category = "GDK")
+	UScoreboardViewModel* Scoreboard;
+
+	// Optional list showing the Scoreboard rows, with a UScoreboardRowWidget entry class. Only visible rows are built
+	UPROPERTY(BlueprintReadOnly, Category = "GDK", meta = (BindWidgetOptional))
+	UListView* ScoreboardList;
+
 	// Called each time the game state changes
 	UFUNCTION(BlueprintImplementableEvent, Category = "GDK")
 	void OnStateUpdated(EMatchState MatchState);
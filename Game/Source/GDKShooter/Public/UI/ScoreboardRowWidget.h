@@ -0,0 +1,34 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "Blueprint/UserWidget.h"
+#include "ScoreboardRowWidget.generated.h"
+
+class UScoreboardEntry;
+
+/**
+ * Base for the row widgets of a scoreboard list view. List views reuse row widgets as they scroll, so this follows
+ * whichever UScoreboardEntry the row is showing and only asks for a refresh when that entry changes.
+ */
+UCLASS(Abstract)
+class GDKSHOOTER_API UScoreboardRowWidget : public UUserWidget, public IUserObjectListEntry
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+	virtual void NativeOnEntryReleased() override;
+
+	// Called when the row starts showing an entry and whenever that entry changes.
+	UFUNCTION(BlueprintImplementableEvent, Category = "GDK")
+	void OnRowUpdated(UScoreboardEntry* Entry);
+
+	UFUNCTION()
+	void OnEntryChanged(UScoreboardEntry* Entry);
+
+	UPROPERTY(BlueprintReadOnly, Category = "GDK")
+	UScoreboardEntry* ShownEntry;
+};
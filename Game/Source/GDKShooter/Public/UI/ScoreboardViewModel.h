@@ -0,0 +1,94 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Game/Components/DeathmatchScoreComponent.h"
+#include "Game/Components/TeamDeathmatchScoreComponent.h"
+#include "UObject/Object.h"
+#include "ScoreboardViewModel.generated.h"
+
+UENUM(BlueprintType)
+enum class EScoreboardRowChange : uint8
+{
+	Insert,
+	Move,
+	Update,
+	Remove
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FScoreboardEntryChanged, class UScoreboardEntry*, Entry);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FScoreboardRowChanged, EScoreboardRowChange, Change, class UScoreboardEntry*, Entry, int32, Index);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FScoreboardRowsChanged);
+
+// One player's row, kept for as long as the player is on the scoreboard so list views can hold on to it.
+UCLASS(BlueprintType)
+class GDKSHOOTER_API UScoreboardEntry : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "Scoreboard")
+	FPlayerScore Score;
+
+	// Empty outside team games.
+	UPROPERTY(BlueprintReadOnly, Category = "Scoreboard")
+	FName TeamName;
+
+	// Position on the scoreboard, starting at 0.
+	UPROPERTY(BlueprintReadOnly, Category = "Scoreboard")
+	int32 Index = INDEX_NONE;
+
+	// Called when this row's score or position changes.
+	UPROPERTY(BlueprintAssignable)
+	FScoreboardEntryChanged OnChanged;
+};
+
+/**
+ * Turns the full score arrays replicated by the score components into row level changes.
+ * Each player keeps the same UScoreboardEntry while they are listed. Applying new scores only touches the rows that
+ * were inserted, moved, updated or removed, and RowsChanged fires only when the order of rows changed.
+ */
+UCLASS(BlueprintType)
+class GDKSHOOTER_API UScoreboardViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Scoreboard")
+	void ApplyPlayerScores(const TArray<FPlayerScore>& Scores);
+
+	// Lists players team by team, in the order the teams are given.
+	UFUNCTION(BlueprintCallable, Category = "Scoreboard")
+	void ApplyTeamScores(const TArray<FTeamScore>& Scores);
+
+	UFUNCTION(BlueprintPure, Category = "Scoreboard")
+	const TArray<UScoreboardEntry*>& GetRows() const { return Rows; }
+
+	UFUNCTION(BlueprintPure, Category = "Scoreboard")
+	UScoreboardEntry* FindRow(int32 PlayerId) const;
+
+	UPROPERTY(BlueprintAssignable)
+	FScoreboardRowChanged RowChanged;
+
+	// Called once per apply when rows were inserted, moved or removed.
+	UPROPERTY(BlueprintAssignable)
+	FScoreboardRowsChanged RowsChanged;
+
+private:
+	// Adds or refreshes the row for Score at the next position of this apply.
+	void ApplyRow(const FPlayerScore& Score, FName TeamName);
+
+	// Removes rows not seen this apply and announces the result.
+	void FinishApply();
+
+	UPROPERTY()
+	TArray<UScoreboardEntry*> Rows;
+
+	UPROPERTY()
+	TMap<int32, UScoreboardEntry*> RowsByPlayerId;
+
+	// Scratch state for an apply in progress.
+	TArray<UScoreboardEntry*> NewRows;
+	bool bOrderChanged = false;
+};
@@ -17,6 +17,7 @@ public:
 	AHoldable();
 	
 	virtual void BeginPlay();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 		
 public:
@@ -42,6 +43,13 @@ public:
 	void OnMetaDataUpdated();
 
 	void SetMetaData(FGDKMetaData MetaData);
+	const FGDKMetaData& GetMetaData() const { return MetaData; }
+
+	bool IsPrimaryInUse() const { return IsPrimaryUsing; }
+	bool IsSecondaryInUse() const { return IsSecondaryUsing; }
+
+	int32 GetCurrentMode() const { return CurrentMode; }
+	void SetCurrentMode(int32 NewMode) { CurrentMode = NewMode; }
 
 	UFUNCTION(BlueprintNativeEvent)
 	void SetIsActive(bool bNewActive);
@@ -11,11 +11,15 @@
  * AInstantWeapon implements hitscan shooting for a single-shot, burst-fire, or full-auto weapon.
  * Hit detection is entirely client-side, with loose server validation.
  * Shot timing and rate-limiting is entirely client-side, with no server validation.
+ * Weapons held by server-controlled pawns, e.g. AI, deal damage directly without the RPCs or validation.
  */
 UCLASS(Abstract, Blueprintable, SpatialType)
 class GDKSHOOTER_API AInstantWeapon : public AWeapon
 {
 	GENERATED_BODY()
+
+	// Fires held weapons directly to time the authoritative path.
+	friend class UBenchmarkRunnerComponent;
 	
 public:
 	AInstantWeapon();
@@ -34,11 +38,18 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Weapons")
 	void OnRenderShot(const FVector Location, bool bImpact);
 
+	// Played at impacts through the local player's UClientFXPoolComponent. Leave unset to play impacts from OnRenderShot.
+	UPROPERTY(EditDefaultsOnly, Category = "Weapons")
+	class UParticleSystem* ImpactFX;
+
 	UFUNCTION(BlueprintImplementableEvent)
 	void FinishedBurst();
 
 	virtual void SetIsActive(bool bNewActive) override;
 
+	// [server] Validates the hit. Returns true if it's valid, false otherwise.
+	bool ValidateHit(const FInstantHitInfo& HitInfo);
+
 protected:
 
 	// [client] Runs a line trace and triggers the server RPC for hits.
@@ -47,19 +58,18 @@ protected:
 	virtual FVector GetLineTraceDirection() override;
 
 private:
-
 	// [server] Notifies clients of a hit.
 	void NotifyClientsOfHit(const FInstantHitInfo& HitInfo, bool bImpact);
 
 	// [client] Spawns the hit FX in the world.
 	void SpawnFX(const FInstantHitInfo& HitInfo, bool bImpact);
 
-	// [server] Validates the hit. Returns true if it's valid, false otherwise.
-	bool ValidateHit(const FInstantHitInfo& HitInfo);
-
 	// [server] Actually deals damage to the actor we hit.
 	void DealDamage(const FInstantHitInfo& HitInfo);
 
+	// True on the server when the weapon isn't held by a remote player, so its own traces can be trusted.
+	bool FiresAuthoritatively() const;
+
 	// [client] Clears the NextShotTimer if it's running.
 	void ClearTimerIfRunning();
 
@@ -0,0 +1,125 @@
+#!/usr/bin/env bash
+# Starts headless simulated player clients on Linux and connects them to a deployment, ramping them up in batches.
+# Stands in for the SimulatedPlayerCoordinator when running load tests locally.
+#
+# Each bot is its own process with its own world and connection. Hosting many simulated player connections in one
+# process isn't supported: outside the editor a map package can only be loaded into one world, so a second game
+# instance in the same process would share the first one's world. The number of bots per machine is limited by the
+# memory and game thread cost of one process per bot, which the script logs while the bots run.
+#
+# Usage: ./LaunchSimPlayerClients.sh <number of bots> [bots per batch] [seconds between batches]
+#
+# Environment:
+#   UNREAL_ENGINE         Engine root, used to run UE4Editor -game when SIM_PLAYER_BINARY isn't set.
+#   SIM_PLAYER_BINARY     A packaged Linux client, e.g. GDKShooter/Binaries/Linux/GDKShooter. Much lighter than the editor.
+#   SIM_PLAYER_HOST       Receptionist host to connect to, defaults to 127.0.0.1.
+#   SIM_PLAYER_MAX_FPS    Frame rate cap per bot, defaults to 20.
+#   SIM_PLAYER_RESTART    Set to 1 to restart bots that exit before the script is stopped.
+#   SIM_PLAYER_LOG_DIR    Where each bot's log is written, defaults to logs/simplayers.
+#   SIM_PLAYER_REPORT_INTERVAL  Seconds between memory reports, defaults to 60.
+
+set -e -u -o pipefail
+if [[ -n "${DEBUG-}" ]]; then
+    set -x
+fi
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_PATH="Game"
+GAME_NAME="GDKShooter"
+
+NUM_BOTS="${1:?Usage: $0 <number of bots> [bots per batch] [seconds between batches]}"
+BATCH_SIZE="${2:-10}"
+BATCH_INTERVAL="${3:-5}"
+
+HOST="${SIM_PLAYER_HOST:-127.0.0.1}"
+MAX_FPS="${SIM_PLAYER_MAX_FPS:-20}"
+RESTART="${SIM_PLAYER_RESTART:-0}"
+LOG_DIR="${SIM_PLAYER_LOG_DIR:-${SCRIPT_DIR}/logs/simplayers}"
+REPORT_INTERVAL="${SIM_PLAYER_REPORT_INTERVAL:-60}"
+
+# No rendering, audio or input, and a frame rate cap, so each bot only costs game thread and networking.
+BOT_ARGS=(
+    "${HOST}"
+    -game
+    -workerType UnrealClient
+    -simulatedPlayer
+    -nullrhi
+    -nosound
+    -nosplash
+    -unattended
+    -nopause
+    -noin
+    -nowrite
+    -NoVerifyGC
+    -nologtimes
+    "-ExecCmds=t.MaxFPS ${MAX_FPS}"
+)
+
+if [[ -n "${SIM_PLAYER_BINARY-}" ]]; then
+    BOT_COMMAND=("${SIM_PLAYER_BINARY}")
+else
+    BOT_COMMAND=("${UNREAL_ENGINE:?Set UNREAL_ENGINE or SIM_PLAYER_BINARY}/Engine/Binaries/Linux/UE4Editor" "${SCRIPT_DIR}/${PROJECT_PATH}/${GAME_NAME}.uproject")
+fi
+
+mkdir -p "${LOG_DIR}"
+
+declare -A BOT_PIDS=()
+
+start_bot() {
+    local BOT_INDEX="${1}"
+    "${BOT_COMMAND[@]}" "${BOT_ARGS[@]}" -abslog="${LOG_DIR}/bot-${BOT_INDEX}.log" > /dev/null 2>&1 &
+    BOT_PIDS["${BOT_INDEX}"]=$!
+}
+
+stop_bots() {
+    echo "Stopping ${#BOT_PIDS[@]} simulated players"
+    for PID in "${BOT_PIDS[@]}"; do
+        kill "${PID}" 2> /dev/null || true
+    done
+    wait || true
+}
+trap stop_bots EXIT
+trap 'exit 130' INT TERM
+
+echo "Starting ${NUM_BOTS} simulated players in batches of ${BATCH_SIZE} every ${BATCH_INTERVAL}s, logs in ${LOG_DIR}"
+
+STARTED=0
+while [[ "${STARTED}" -lt "${NUM_BOTS}" ]]; do
+    for (( i = 0; i < BATCH_SIZE && STARTED < NUM_BOTS; i++ )); do
+        start_bot "${STARTED}"
+        STARTED=$((STARTED + 1))
+    done
+    echo "$(date +%T) ${STARTED}/${NUM_BOTS} simulated players started"
+
+    if [[ "${STARTED}" -lt "${NUM_BOTS}" ]]; then
+        sleep "${BATCH_INTERVAL}"
+    fi
+done
+
+# Keep the bots running until stopped, restarting any that exit if asked to.
+LAST_REPORT="${SECONDS}"
+while true; do
+    sleep 5
+    RUNNING=0
+    for BOT_INDEX in "${!BOT_PIDS[@]}"; do
+        if kill -0 "${BOT_PIDS[${BOT_INDEX}]}" 2> /dev/null; then
+            RUNNING=$((RUNNING + 1))
+        elif [[ "${RESTART}" == "1" ]]; then
+            echo "$(date +%T) Restarting simulated player ${BOT_INDEX}"
+            start_bot "${BOT_INDEX}"
+            RUNNING=$((RUNNING + 1))
+        fi
+    done
+
+    if [[ "${RUNNING}" -eq 0 ]]; then
+        echo "All simulated players have exited"
+        exit 0
+    fi
+
+    # Resident memory of the running bots, to work out how many one machine can take.
+    if [[ $((SECONDS - LAST_REPORT)) -ge "${REPORT_INTERVAL}" ]]; then
+        LAST_REPORT="${SECONDS}"
+        TOTAL_KB="$(ps -o rss= -p "$(IFS=,; echo "${BOT_PIDS[*]}")" 2> /dev/null | awk '{ Total += $1 } END { print Total + 0 }')"
+        echo "$(date +%T) ${RUNNING} simulated players running, $((TOTAL_KB / 1024)) MB resident, $((TOTAL_KB / 1024 / RUNNING)) MB per bot"
+    fi
+done
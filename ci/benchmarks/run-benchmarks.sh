@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+# Runs the server benchmarks headless and prints the results, optionally against an earlier run.
+#
+# Usage: ci/benchmarks/run-benchmarks.sh <label> [baseline json]
+#
+# Starts a dedicated server without SpatialOS and rendering, which runs UBenchmarkRunnerComponent (it has to be on the
+# GameState), writes Game/Saved/Profiling/Benchmark-<label>.json and exits. Keep the JSON files as build artifacts to track
+# the numbers over time. Given a baseline, fails if any benchmark's median got slower by more than BENCHMARK_THRESHOLD.
+#
+# Environment:
+#   UNREAL_ENGINE          Engine root containing Engine/Binaries/Linux/UE4Editor.
+#   BENCHMARK_MAP          Map to benchmark in, defaults to the project's default server map.
+#   BENCHMARK_THRESHOLD    Percent increase in a median counted as a regression, defaults to 20.
+
+set -e -u -o pipefail
+if [[ -n "${DEBUG-}" ]]; then
+    set -x
+fi
+
+EXAMPLEPROJECT_HOME="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+LABEL="${1:?Usage: $0 <label> [baseline json]}"
+BASELINE="${2:-}"
+
+BENCHMARK_MAP="${BENCHMARK_MAP:-}"
+BENCHMARK_THRESHOLD="${BENCHMARK_THRESHOLD:-20}"
+
+LOG_DIR="${EXAMPLEPROJECT_HOME}/logs/benchmarks"
+RESULTS="${EXAMPLEPROJECT_HOME}/Game/Saved/Profiling/Benchmark-${LABEL}.json"
+mkdir -p "${LOG_DIR}"
+rm -f "${RESULTS}"
+
+echo "--- Running benchmarks ${LABEL}"
+"${UNREAL_ENGINE:?Set UNREAL_ENGINE}/Engine/Binaries/Linux/UE4Editor" "${EXAMPLEPROJECT_HOME}/Game/GDKShooter.uproject" ${BENCHMARK_MAP} \
+    -server -nullrhi -nosound -unattended -nopause -noin -NoVerifyGC -nologtimes -OverrideSpatialNetworking=false \
+    -GDKBenchmark="${LABEL}" -abslog="${LOG_DIR}/${LABEL}.log"
+
+if [[ ! -f "${RESULTS}" ]]; then
+    echo "The server didn't write ${RESULTS}, see ${LOG_DIR}/${LABEL}.log"
+    exit 1
+fi
+
+python3 - "${RESULTS}" "${BASELINE}" "${BENCHMARK_THRESHOLD}" <<'PYTHON'
+import json
+import sys
+
+results = json.load(open(sys.argv[1]))
+baseline = {}
+if sys.argv[2]:
+    baseline = {(r["name"], r["actors"]): r for r in json.load(open(sys.argv[2]))["results"]}
+threshold = float(sys.argv[3])
+
+regressions = []
+print("{:<20} {:>7} {:>14} {:>14} {:>9}".format("Benchmark", "Actors", "Median ns/op", "p90 ns/op", "Change"))
+for result in results["results"]:
+    change = ""
+    base = baseline.get((result["name"], result["actors"]))
+    if base is not None and base["medianNs"] > 0:
+        percent = (result["medianNs"] - base["medianNs"]) / base["medianNs"] * 100.0
+        change = "{:+.1f}%".format(percent)
+        if percent > threshold:
+            regressions.append("{} x{}".format(result["name"], result["actors"]))
+    print("{:<20} {:>7} {:>14.1f} {:>14.1f} {:>9}".format(result["name"], result["actors"], result["medianNs"], result["p90Ns"], change))
+
+if regressions:
+    print("\nMedian slower by more than {}%: {}".format(threshold, ", ".join(regressions)))
+    sys.exit(1)
+PYTHON
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+# Compares the function timings of two input replays, written by replay.sh, and fails if any function got slower.
+#
+# Usage: ci/input-replay/compare-timings.py <base csv> <candidate csv> [--threshold <percent>] [--min-ms <ms>]
+
+import argparse
+import csv
+import sys
+
+
+def read_timings(path):
+    with open(path) as f:
+        return {row["Name"]: row for row in csv.DictReader(f)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("base")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=10.0, help="Percent increase in total time counted as a regression.")
+    parser.add_argument("--min-ms", type=float, default=1.0, help="Ignore functions whose total time is below this in both runs.")
+    args = parser.parse_args()
+
+    base = read_timings(args.base)
+    candidate = read_timings(args.candidate)
+
+    regressions = []
+    print("{:<32} {:>10} {:>12} {:>12} {:>8}".format("Function", "Calls", "Base ms", "Candidate ms", "Change"))
+    for name in sorted(set(base) | set(candidate), key=lambda n: -float(candidate.get(n, base.get(n))["TotalMs"])):
+        base_ms = float(base[name]["TotalMs"]) if name in base else 0.0
+        candidate_ms = float(candidate[name]["TotalMs"]) if name in candidate else 0.0
+        calls = candidate[name]["Calls"] if name in candidate else "-"
+
+        if base_ms > 0.0:
+            change = (candidate_ms - base_ms) / base_ms * 100.0
+            change_text = "{:+.1f}%".format(change)
+        else:
+            change = float("inf")
+            change_text = "new"
+
+        print("{:<32} {:>10} {:>12.2f} {:>12.2f} {:>8}".format(name, calls, base_ms, candidate_ms, change_text))
+
+        if max(base_ms, candidate_ms) >= args.min_ms and change > args.threshold:
+            regressions.append(name)
+
+    # Differing call counts mean the replays diverged, so the times aren't comparable.
+    diverged = [n for n in set(base) & set(candidate) if n != "Frame" and base[n]["Calls"] != candidate[n]["Calls"]]
+    if diverged:
+        print("\nWarning: call counts differ for {}, the replays may not have run the same workload".format(", ".join(sorted(diverged))))
+
+    if regressions:
+        print("\nSlower by more than {}%: {}".format(args.threshold, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
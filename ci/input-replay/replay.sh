@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+# Replays recorded player input on a headless server and writes the time spent in each instrumented function.
+#
+# Usage: ci/input-replay/replay.sh <recordings dir> <label>
+#
+# Record input by starting clients with -RecordInput. Each client writes Game/Saved/InputRecordings/<player>-<date>.input
+# when it leaves. Copy the recordings of one session into a directory and replay it against two builds, then compare the
+# results with compare-timings.py. See UInputReplayComponent, which has to be on the GameState.
+# Timings are written to Game/Saved/Profiling/InputReplay-<label>.csv.
+#
+# Environment:
+#   UNREAL_ENGINE      Engine root containing Engine/Binaries/Linux/UE4Editor.
+#   REPLAY_MAP         Map to replay on, defaults to the project's default server map.
+#   REPLAY_SEED        Seed for gameplay randomness, defaults to 1. Use the same seed for runs that are compared.
+#   REPLAY_FPS         Fixed frame rate the replay is stepped at, defaults to 30.
+
+set -e -u -o pipefail
+if [[ -n "${DEBUG-}" ]]; then
+    set -x
+fi
+
+EXAMPLEPROJECT_HOME="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+RECORDINGS="$(cd "${1:?Usage: $0 <recordings dir> <label>}" && pwd)"
+LABEL="${2:?Usage: $0 <recordings dir> <label>}"
+
+REPLAY_MAP="${REPLAY_MAP:-}"
+REPLAY_SEED="${REPLAY_SEED:-1}"
+REPLAY_FPS="${REPLAY_FPS:-30}"
+
+LOG_DIR="${EXAMPLEPROJECT_HOME}/logs/input-replay"
+mkdir -p "${LOG_DIR}"
+
+echo "--- Replaying $(ls "${RECORDINGS}"/*.input | wc -l) recordings from ${RECORDINGS} as ${LABEL}"
+# Runs without SpatialOS, so the replay doesn't depend on a deployment. -benchmark with -fps steps the world by a fixed
+# time, so frame N sees the same input on every run however long frames take.
+"${UNREAL_ENGINE:?Set UNREAL_ENGINE}/Engine/Binaries/Linux/UE4Editor" "${EXAMPLEPROJECT_HOME}/Game/GDKShooter.uproject" ${REPLAY_MAP} \
+    -server -nullrhi -nosound -unattended -nopause -noin -NoVerifyGC -nologtimes -OverrideSpatialNetworking=false \
+    -benchmark -fps="${REPLAY_FPS}" -GDKRandomSeed="${REPLAY_SEED}" \
+    -InputReplay="${RECORDINGS}" -InputReplayLabel="${LABEL}" -abslog="${LOG_DIR}/${LABEL}.log"
+
+REPORT="${EXAMPLEPROJECT_HOME}/Game/Saved/Profiling/InputReplay-${LABEL}.csv"
+if [[ ! -f "${REPORT}" ]]; then
+    echo "The replay didn't write ${REPORT}, see ${LOG_DIR}/${LABEL}.log"
+    exit 1
+fi
+echo "Timings written to ${REPORT}"
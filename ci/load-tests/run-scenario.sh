@@ -0,0 +1,115 @@
+#!/usr/bin/env bash
+# Runs a load test scenario against a local deployment and fails if any server worker exceeded the scenario's thresholds.
+#
+# Usage: ci/load-tests/run-scenario.sh <scenario json>
+#
+# The scenario file is read twice. This script uses launchConfig, serverWorkers, players, joinBatchSize and
+# joinIntervalSeconds to start the deployment, servers and simulated players. Each server worker loads the
+# phases and thresholds through -LoadTestScenario. See ULoadTestScenarioComponent, which has to be on the GameState.
+# Each server worker runs the phases, writes Game/Saved/Profiling/LoadTest-<name>-<worker>.json and exits.
+#
+# Environment:
+#   UNREAL_ENGINE                Engine root containing Engine/Binaries/Linux/UE4Editor.
+#   DEPLOYMENT_STARTUP_SECONDS   Seconds to wait for the local deployment before starting servers, defaults to 30.
+#   SERVER_STARTUP_SECONDS       Seconds to wait for the servers before starting simulated players, defaults to 60.
+#   Also see LaunchSimPlayerClients.sh, which starts the simulated players.
+
+set -e -u -o pipefail
+if [[ -n "${DEBUG-}" ]]; then
+    set -x
+fi
+
+EXAMPLEPROJECT_HOME="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+SCENARIO="$(cd "$(dirname "${1:?Usage: $0 <scenario json>}")" && pwd)/$(basename "${1}")"
+
+DEPLOYMENT_STARTUP_SECONDS="${DEPLOYMENT_STARTUP_SECONDS:-30}"
+SERVER_STARTUP_SECONDS="${SERVER_STARTUP_SECONDS:-60}"
+
+scenario_value() {
+    python3 -c "import json, sys; print(json.load(open(sys.argv[1])).get(sys.argv[2], sys.argv[3]))" "${SCENARIO}" "${1}" "${2}"
+}
+
+NAME="$(scenario_value name "$(basename "${SCENARIO}" .json)")"
+LAUNCH_CONFIG="$(scenario_value launchConfig one_worker_test.json)"
+SERVER_WORKERS="$(scenario_value serverWorkers 1)"
+PLAYERS="$(scenario_value players 10)"
+JOIN_BATCH_SIZE="$(scenario_value joinBatchSize "${PLAYERS}")"
+JOIN_INTERVAL="$(scenario_value joinIntervalSeconds 0)"
+# Give the servers the length of the scenario plus startup and a margin before giving up on them.
+SCENARIO_SECONDS="$(python3 -c "import json, sys; print(int(sum(p['duration'] for p in json.load(open(sys.argv[1]))['phases'])))" "${SCENARIO}")"
+TIMEOUT_SECONDS=$((SCENARIO_SECONDS + SERVER_STARTUP_SECONDS + 300))
+
+REPORT_DIR="${EXAMPLEPROJECT_HOME}/Game/Saved/Profiling"
+LOG_DIR="${EXAMPLEPROJECT_HOME}/logs/load-tests/${NAME}"
+mkdir -p "${REPORT_DIR}" "${LOG_DIR}"
+rm -f "${REPORT_DIR}/LoadTest-${NAME}-"*.json
+
+DEPLOYMENT_PID=""
+SERVER_PIDS=()
+SIM_PLAYERS_PID=""
+
+cleanup() {
+    for PID in ${SIM_PLAYERS_PID} ${SERVER_PIDS[@]+"${SERVER_PIDS[@]}"} ${DEPLOYMENT_PID}; do
+        kill "${PID}" 2> /dev/null || true
+    done
+    wait || true
+}
+trap cleanup EXIT
+trap 'exit 130' INT TERM
+
+echo "--- Starting local deployment with ${LAUNCH_CONFIG}"
+pushd "${EXAMPLEPROJECT_HOME}/spatial" > /dev/null
+spatial worker build build-config
+spatial local launch "${LAUNCH_CONFIG}" --snapshot=snapshots/default.snapshot --runtime_version=0.4.3 > "${LOG_DIR}/deployment.log" 2>&1 &
+DEPLOYMENT_PID=$!
+popd > /dev/null
+sleep "${DEPLOYMENT_STARTUP_SECONDS}"
+
+echo "--- Starting ${SERVER_WORKERS} server workers"
+for (( i = 0; i < SERVER_WORKERS; i++ )); do
+    "${UNREAL_ENGINE:?Set UNREAL_ENGINE}/Engine/Binaries/Linux/UE4Editor" "${EXAMPLEPROJECT_HOME}/Game/GDKShooter.uproject" \
+        -server -workerType UnrealWorker -nullrhi -nosound -unattended -nopause -noin -NoVerifyGC -nologtimes \
+        -LoadTestScenario="${SCENARIO}" -abslog="${LOG_DIR}/server-${i}.log" > /dev/null 2>&1 &
+    SERVER_PIDS+=($!)
+done
+sleep "${SERVER_STARTUP_SECONDS}"
+
+echo "--- Starting ${PLAYERS} simulated players"
+SIM_PLAYER_LOG_DIR="${LOG_DIR}/simplayers" "${EXAMPLEPROJECT_HOME}/LaunchSimPlayerClients.sh" "${PLAYERS}" "${JOIN_BATCH_SIZE}" "${JOIN_INTERVAL}" > "${LOG_DIR}/simplayers.log" 2>&1 &
+SIM_PLAYERS_PID=$!
+
+echo "--- Running ${NAME} for ${SCENARIO_SECONDS}s"
+DEADLINE=$((SECONDS + TIMEOUT_SECONDS))
+for PID in "${SERVER_PIDS[@]}"; do
+    while kill -0 "${PID}" 2> /dev/null; do
+        if [[ "${SECONDS}" -ge "${DEADLINE}" ]]; then
+            echo "Server workers didn't finish within ${TIMEOUT_SECONDS}s, see ${LOG_DIR}"
+            exit 1
+        fi
+        sleep 5
+    done
+done
+
+echo "--- Checking reports"
+REPORTS=("${REPORT_DIR}/LoadTest-${NAME}-"*.json)
+if [[ ! -e "${REPORTS[0]}" || "${#REPORTS[@]}" -lt "${SERVER_WORKERS}" ]]; then
+    echo "Expected a report from each of the ${SERVER_WORKERS} server workers in ${REPORT_DIR}, see ${LOG_DIR}"
+    exit 1
+fi
+
+python3 - "${REPORTS[@]}" <<'EOF'
+import json
+import sys
+
+passed = True
+for path in sys.argv[1:]:
+    report = json.load(open(path))
+    print("{} on {}: {}".format(report["scenario"], report["worker"], "passed" if report["passed"] else "FAILED"))
+    for phase in report["phases"]:
+        print("  {:<24} frame ms {}, out B/s {}, entities {}".format(phase["name"], phase["frameTimeMs"], phase["outBytesPerConnection"], phase["maxEntities"]))
+    for failure in report["failures"]:
+        print("  " + failure)
+    passed = passed and report["passed"]
+
+sys.exit(0 if passed else 1)
+EOF